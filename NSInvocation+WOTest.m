@@ -68,16 +68,17 @@
     NSParameterAssert(index < [methodSignature numberOfArguments]);
     const char *type = [methodSignature getArgumentTypeAtIndex:index];
 
-    // no way to find out size needed for argument, so allocate enough for all
-    size_t bufferSize = (size_t)[methodSignature frameLength];
+    // NSGetSizeAndAlignment copes with every encoding the runtime produces; the qualifiers (const, in, out, bycopy etc) are
+    // then dropped so that the returned value can be handled by the rest of WOTest
+    NSUInteger bufferSize;
+    NSGetSizeAndAlignment(type, &bufferSize, NULL);
+    while (*type && strchr("rnNoORV", *type))
+        type++;
     void *buffer = malloc(bufferSize);
     NSAssert1((buffer != NULL), @"malloc() failed (size %d)", bufferSize);
-    [self getArgument:&buffer atIndex:index];
-    NSValue *aValue = [NSValue value:&buffer withObjCType:type];
-
-    // following line yields a runtime error:
-    // malloc: ***  Deallocation of a pointer not malloced: 0x26a45c; This could be a double free(), or free() called with the middle of an allocated block; Try setting environment variable MallocHelp to see tools to help debug
-    //free(buffer); // is NSValue freeing automatically?
+    [self getArgument:buffer atIndex:index];
+    NSValue *aValue = [NSValue value:buffer withObjCType:type];
+    free(buffer);
     return aValue;
 }
 
@@ -25,11 +25,94 @@
 // system headers
 #import <objc/objc-runtime.h>
 #import <objc/Protocol.h>
+#import <mach-o/dyld.h>
+#import <pthread.h>
 
 // other headers
 #import "NSScanner+WOTest.h"
 #import "NSValue+WOTest.h"
 
+#pragma mark -
+#pragma mark Class index
+
+// sets of all registered classes and of their metaclasses, hashed by pointer identity; built lazily and rebuilt after
+// new images are loaded, or when a lookup misses and the runtime reports a different number of classes (classes can
+// also be created at runtime with objc_allocateClassPair)
+static CFMutableSetRef  WOClassIndex            = NULL;
+static CFMutableSetRef  WOMetaClassIndex        = NULL;
+static int              WOClassIndexCount       = 0;
+static volatile BOOL    WOClassIndexStale       = YES;
+static pthread_mutex_t  WOClassIndexMutex       = PTHREAD_MUTEX_INITIALIZER;
+
+static void WOClassIndexImageAdded(const struct mach_header *header, intptr_t slide)
+{
+    WOClassIndexStale = YES;
+}
+
+// must be called with WOClassIndexMutex held
+static void WOClassIndexRebuild(void)
+{
+    int     numClasses      = 0;
+    int     newNumClasses   = objc_getClassList(NULL, 0);
+    Class   *classes        = NULL;
+
+    // get list of all classes on the system
+    while (numClasses < newNumClasses)
+    {
+        numClasses          = newNumClasses;
+        size_t bufferSize   = sizeof(Class) * numClasses;
+        classes             = realloc(classes, bufferSize);
+        NSCAssert1((classes != NULL), @"realloc() failed (size %d)", bufferSize);
+        newNumClasses       = objc_getClassList(classes, numClasses);
+    }
+
+    if (!WOClassIndex)
+    {
+        WOClassIndex        = CFSetCreateMutable(NULL, newNumClasses, NULL);
+        WOMetaClassIndex    = CFSetCreateMutable(NULL, newNumClasses, NULL);
+
+        // the callback is invoked immediately for images already loaded, so the index is only marked stale afterwards
+        _dyld_register_func_for_add_image(WOClassIndexImageAdded);
+    }
+    else
+    {
+        CFSetRemoveAllValues(WOClassIndex);
+        CFSetRemoveAllValues(WOMetaClassIndex);
+    }
+
+    if (classes)
+    {
+        for (int i = 0; i < newNumClasses; i++)
+        {
+            if (class_isMetaClass(classes[i]))  // looking at a meta class
+                CFSetAddValue(WOMetaClassIndex, classes[i]);
+            else                                // not looking at a meta class, add it and its meta class
+            {
+                CFSetAddValue(WOClassIndex, classes[i]);
+                CFSetAddValue(WOMetaClassIndex, object_getClass(classes[i]));
+            }
+        }
+        free(classes);
+    }
+    WOClassIndexCount   = newNumClasses;
+    WOClassIndexStale   = NO;
+}
+
+static BOOL WOClassIndexContains(Class aClass, BOOL metaClass)
+{
+    pthread_mutex_lock(&WOClassIndexMutex);
+    if (WOClassIndexStale)
+        WOClassIndexRebuild();
+    BOOL found = CFSetContainsValue(metaClass ? WOMetaClassIndex : WOClassIndex, aClass);
+    if (!found && objc_getClassList(NULL, 0) != WOClassIndexCount)
+    {
+        WOClassIndexRebuild();
+        found = CFSetContainsValue(metaClass ? WOMetaClassIndex : WOClassIndex, aClass);
+    }
+    pthread_mutex_unlock(&WOClassIndexMutex);
+    return found;
+}
+
 @implementation NSObject (WOTest)
 
 + (NSString *)WOTest_descriptionForObject:(id)anObject
@@ -71,82 +154,14 @@
 + (BOOL)WOTest_isRegisteredClass:(Class)aClass
 {
     if (!aClass) return NO;
-
-    BOOL    isRegisteredClass   = NO;
-    int     numClasses          = 0;
-    int     newNumClasses       = objc_getClassList(NULL, 0);
-    Class   *classes            = NULL;
-
-    // get list of all classes on the system
-    while (numClasses < newNumClasses)
-    {
-        numClasses          = newNumClasses;
-        size_t bufferSize   = sizeof(Class) * numClasses;
-        classes             = realloc(classes, bufferSize);
-        NSAssert1((classes != NULL), @"realloc() failed (size %d)", bufferSize);
-        newNumClasses       = objc_getClassList(classes, numClasses);
-    }
-
-    if (classes)
-    {
-        for (int i = 0; i < newNumClasses; i++)
-        {
-            if (aClass == classes[i])   // found in list!
-            {
-                isRegisteredClass = YES;
-                break;
-            }
-        }
-        free(classes);
-    }
-    return isRegisteredClass;
+    return WOClassIndexContains(aClass, NO);
 }
 
 /*! Returns YES if aClass is the metaclass of a class that is registered with the runtime. */
 + (BOOL)WOTest_isMetaClass:(Class)aClass
 {
     if (!aClass) return NO;
-
-    BOOL    isMetaClass     = NO;
-    int     numClasses      = 0;
-    int     newNumClasses   = objc_getClassList(NULL, 0);
-    Class   *classes        = NULL;
-
-    // get a list of all classes on the system
-    // get list of all classes on the system
-    while (numClasses < newNumClasses)
-    {
-        numClasses          = newNumClasses;
-        size_t bufferSize   = sizeof(Class) * numClasses;
-        classes             = realloc(classes, bufferSize);
-        NSAssert1((classes != NULL), @"realloc() failed (size %d)", bufferSize);
-        newNumClasses       = objc_getClassList(classes, numClasses);
-    }
-
-    if (classes)
-    {
-        for (int i = 0; i < newNumClasses; i++)
-        {
-            if (class_isMetaClass(classes[i]))  // looking at a meta class
-            {
-                if (aClass == classes[i])       // found in list!
-                {
-                    isMetaClass = YES;
-                    break;
-                }
-            }
-            else // not looking at a meta class, look up its meta class
-            {
-                if (aClass == object_getClass(classes[i])) // found it!
-                {
-                    isMetaClass = YES;
-                    break;
-                }
-            }
-        }
-        free(classes);
-    }
-    return isMetaClass;
+    return WOClassIndexContains(aClass, YES);
 }
 
 + (BOOL)WOTest_object:(id)anObject isKindOfClass:(Class)aClass
@@ -27,6 +27,12 @@ void _WOLog(NSString *format, ...);
 /*! This function is an alternative to NSLogv that accepts the same kinds of format specifiers (including the "%@" format specifier to print object descriptions) but which omits the prelimary information that is prepended by NSLogv (date, time, process name, process number). Named with a preceding underscore for consistency with the _WOLog function. */
 void _WOLogv(NSString *format, va_list args);
 
+/*! Lines logged with _WOLog and _WOLogv are queued in a fixed-size buffer and written to stdout by a background thread. This function blocks until everything logged so far has been written. It is called automatically at exit and before fork(), and WOTest calls it whenever it reports a failure; call it before writing directly to stdout if ordering matters. */
+void _WOLogFlush(void);
+
+/*! For use on crash paths where the writer thread may never run again: writes whatever is buffered directly with write(2), without waiting for locks or for the writer thread. Bytes the writer thread is in the middle of writing are skipped, so output may be lost at the crash but is never duplicated. */
+void _WOLogPanicFlush(void);
+
 @interface NSString (WOTest)
 
 + (NSString *)WOTest_stringWithFormat:(NSString *)format arguments:(va_list)argList;
@@ -39,6 +45,8 @@ void _WOLogv(NSString *format, va_list args);
 /*! Returns an immutable string created by "collapsing" all of the whitespace in the receiver into single spaces. All newlines are converted into spaces and consecutive spaces are "collapsed" into a single space. */
 - (NSString *)WOTest_stringByCollapsingWhitespace;
 
+/*! Like WOTest_stringByCollapsingWhitespace but stops once the collapsed string is \p index characters long, without examining the rest of the receiver. Sets \p didTruncate (if not NULL) to indicate whether any characters were left out. An \p index of 0 means no limit. */
+- (NSString *)WOTest_stringByCollapsingWhitespaceTruncatedAt:(NSUInteger)index didTruncate:(BOOL *)didTruncate;
 
 /*! Returns an immutable string created by appending a single character of type unichar to the receiver. */
 - (NSString *)WOTest_stringByAppendingCharacter:(unichar)character;
@@ -21,17 +21,198 @@
 
 #import "NSString+WOTest.h"
 
+// system headers
+#import <pthread.h>
+#import <signal.h>
+#import <unistd.h>                  /* write() */
+
+#pragma mark -
+#pragma mark Buffered log writer
+
+#define WO_LOG_BUFFER_SIZE  (64 * 1024)
+
+// ring buffer of bytes waiting to be written to stdout; WOLogCount includes the WOLogClaimed bytes (starting at WOLogHead)
+// which the writer thread is currently writing, if any
+static char             WOLogBuffer[WO_LOG_BUFFER_SIZE];
+static size_t           WOLogHead           = 0;
+static size_t           WOLogCount          = 0;
+static volatile size_t  WOLogClaimed        = 0;
+static BOOL             WOLogWriterStarted  = NO;
+static BOOL             WOLogWriterFailed   = NO;
+static pthread_mutex_t  WOLogMutex          = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   WOLogNotEmpty       = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t   WOLogDrained        = PTHREAD_COND_INITIALIZER;     // signalled whenever space is freed up
+
+static void WOLogWriteBytes(const char *bytes, size_t length)
+{
+    fwrite(bytes, 1, length, stdout);
+    fflush(stdout);
+}
+
+static void *WOLogWriterMain(void *arg)
+{
+    pthread_mutex_lock(&WOLogMutex);
+    while (1)
+    {
+        while (WOLogCount == 0)
+            pthread_cond_wait(&WOLogNotEmpty, &WOLogMutex);
+
+        // write the contiguous part of the buffered bytes outside the lock; producers only ever append after them
+        size_t length = MIN(WOLogCount, WO_LOG_BUFFER_SIZE - WOLogHead);
+        WOLogClaimed = length;
+        pthread_mutex_unlock(&WOLogMutex);
+        WOLogWriteBytes(WOLogBuffer + WOLogHead, length);
+        pthread_mutex_lock(&WOLogMutex);
+        WOLogClaimed = 0;
+        WOLogHead = (WOLogHead + length) % WO_LOG_BUFFER_SIZE;
+        WOLogCount -= length;
+        pthread_cond_broadcast(&WOLogDrained);
+    }
+    return NULL;
+}
+
+// must be called with the lock held; returns with it held
+static void WOLogWaitUntilDrained(void)
+{
+    while (WOLogCount > 0 || WOLogClaimed > 0)
+        pthread_cond_wait(&WOLogDrained, &WOLogMutex);
+}
+
+static void WOLogPrepareForFork(void)
+{
+    // the child gets no writer thread, so nothing may be left in the buffer
+    pthread_mutex_lock(&WOLogMutex);
+    WOLogWaitUntilDrained();
+}
+
+static void WOLogParentAfterFork(void)
+{
+    pthread_mutex_unlock(&WOLogMutex);
+}
+
+static void WOLogChildAfterFork(void)
+{
+    pthread_mutex_init(&WOLogMutex, NULL);
+    pthread_cond_init(&WOLogNotEmpty, NULL);
+    pthread_cond_init(&WOLogDrained, NULL);
+    WOLogHead           = 0;
+    WOLogCount          = 0;
+    WOLogClaimed        = 0;
+    WOLogWriterStarted  = NO;   // started again on demand
+}
+
+static void WOLogCrashHandler(int signalNumber)
+{
+    // handler was installed with SA_RESETHAND, so re-raising gets the default behaviour (and a crash report)
+    _WOLogPanicFlush();
+    raise(signalNumber);
+}
+
+// must be called with the lock held
+static void WOLogStartWriter(void)
+{
+    static BOOL handlersInstalled = NO;
+    if (!handlersInstalled)
+    {
+        atexit(_WOLogFlush);
+        pthread_atfork(WOLogPrepareForFork, WOLogParentAfterFork, WOLogChildAfterFork);
+
+        // write out buffered lines before crashes which nobody else handles (WOTest's own low-level exception handling and
+        // any handlers installed by the code under test take precedence)
+        int signals[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT };
+        for (unsigned i = 0; i < sizeof(signals) / sizeof(signals[0]); i++)
+        {
+            struct sigaction action, previous;
+            if (sigaction(signals[i], NULL, &previous) == 0 && previous.sa_handler == SIG_DFL)
+            {
+                memset(&action, 0, sizeof(action));
+                action.sa_handler   = WOLogCrashHandler;
+                action.sa_flags     = SA_RESETHAND;
+                sigemptyset(&action.sa_mask);
+                sigaction(signals[i], &action, NULL);
+            }
+        }
+        handlersInstalled = YES;
+    }
+
+    pthread_t       thread;
+    pthread_attr_t  attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&thread, &attributes, WOLogWriterMain, NULL) == 0)
+        WOLogWriterStarted = YES;
+    else
+        WOLogWriterFailed = YES;    // fall back to writing synchronously
+    pthread_attr_destroy(&attributes);
+}
+
+static void WOLogAppendLine(const char *line)
+{
+    size_t length = strlen(line) + 1; // plus newline
+    pthread_mutex_lock(&WOLogMutex);
+    if (!WOLogWriterStarted && !WOLogWriterFailed)
+        WOLogStartWriter();
+
+    if (WOLogWriterFailed || length > WO_LOG_BUFFER_SIZE)
+    {
+        // write directly (lines this long are rare); holding the lock keeps the output in order
+        WOLogWaitUntilDrained();
+        fprintf(stdout, "%s\n", line);
+        fflush(stdout);
+        pthread_mutex_unlock(&WOLogMutex);
+        return;
+    }
+
+    while (WO_LOG_BUFFER_SIZE - WOLogCount < length)
+        pthread_cond_wait(&WOLogDrained, &WOLogMutex);
+
+    size_t tail     = (WOLogHead + WOLogCount) % WO_LOG_BUFFER_SIZE;
+    size_t first    = MIN(length - 1, WO_LOG_BUFFER_SIZE - tail);
+    memcpy(WOLogBuffer + tail, line, first);
+    memcpy(WOLogBuffer, line + first, length - 1 - first);
+    WOLogBuffer[(tail + length - 1) % WO_LOG_BUFFER_SIZE] = '\n';
+    WOLogCount += length;
+    pthread_cond_signal(&WOLogNotEmpty);
+    pthread_mutex_unlock(&WOLogMutex);
+}
+
+void _WOLogFlush(void)
+{
+    pthread_mutex_lock(&WOLogMutex);
+    WOLogWaitUntilDrained();
+    pthread_mutex_unlock(&WOLogMutex);
+}
+
+void _WOLogPanicFlush(void)
+{
+    // take the lock if it is free so as to see a consistent buffer; it can't be waited for, as the crashing thread (or one
+    // which will never run again) may hold it, in which case the unlocked values are the best there is
+    BOOL locked = (pthread_mutex_trylock(&WOLogMutex) == 0);
+
+    // the chunk claimed by the writer thread may be partly written already; it is skipped rather than written again, so a
+    // crash in the middle of it loses the unwritten part of that chunk instead of duplicating the written part
+    size_t claimed  = MIN(WOLogClaimed, WOLogCount);
+    size_t head     = (WOLogHead + claimed) % WO_LOG_BUFFER_SIZE;
+    size_t count    = WOLogCount - claimed;
+    size_t first    = MIN(count, WO_LOG_BUFFER_SIZE - head);
+    write(STDOUT_FILENO, WOLogBuffer + head, first);
+    write(STDOUT_FILENO, WOLogBuffer, count - first);
+
+    // leave the claimed chunk for the writer thread to account for, should it get that far
+    WOLogCount = claimed;
+    if (locked)
+        pthread_mutex_unlock(&WOLogMutex);
+}
+
+#pragma mark -
+#pragma mark Logging functions
+
 void _WOLog(NSString *format, ...)
 {
     if (!format) return; // bail
     va_list args;
     va_start(args, format);
-    NSString *string = [[NSString alloc] initWithFormat:format arguments:args];
-    if (string)
-    {
-        fprintf(stdout, "%s\n", [string UTF8String]);
-        fflush(NULL); // flush all open streams (not just stdout)
-    }
+    _WOLogv(format, args);
     va_end(args);
 }
 
@@ -40,12 +221,14 @@ void _WOLogv(NSString *format, va_list args)
     if (!format) return; // bail
     NSString *string = [[NSString alloc] initWithFormat:format arguments:args];
     if (string)
-    {
-        fprintf(stdout, "%s\n", [string UTF8String]);
-        fflush(NULL); // flush all open streams (not just stdout)
-    }
+        WOLogAppendLine([string UTF8String]);
 }
 
+#pragma mark -
+
+// characters fetched per getCharacters:range: call when collapsing whitespace
+#define WO_COLLAPSE_BLOCK_SIZE  256
+
 @implementation NSString (WOTest)
 
 + (NSString *)WOTest_stringWithFormat:(NSString *)format arguments:(va_list)argList
@@ -70,27 +253,46 @@ void _WOLogv(NSString *format, va_list args)
 
 - (NSString *)WOTest_stringByCollapsingWhitespace
 {
+    return [self WOTest_stringByCollapsingWhitespaceTruncatedAt:0 didTruncate:NULL];
+}
+
+- (NSString *)WOTest_stringByCollapsingWhitespaceTruncatedAt:(NSUInteger)index didTruncate:(BOOL *)didTruncate
+{
+    NSUInteger      length      = [self length];
+    NSUInteger      capacity    = (index > 0) ? MIN(length, index) : length;
+    unichar         *output     = malloc(MAX(capacity, (NSUInteger)1) * sizeof(unichar));
+    NSAssert(output != NULL, @"malloc() failed");
     NSCharacterSet  *whitespace = [NSCharacterSet whitespaceAndNewlineCharacterSet];
-    NSMutableString *temp       = [NSMutableString stringWithString:self];
-    unsigned int    length      = [temp length];
-    for (unsigned int i = 0; i < length; i++)
+    unichar         input[WO_COLLAPSE_BLOCK_SIZE];
+    NSUInteger      count       = 0;
+    BOOL            truncated   = NO;
+    for (NSUInteger offset = 0; offset < length && !truncated; offset += WO_COLLAPSE_BLOCK_SIZE)
     {
-        if ([whitespace characterIsMember:[temp characterAtIndex:i]])
+        NSRange block = NSMakeRange(offset, MIN(length - offset, (NSUInteger)WO_COLLAPSE_BLOCK_SIZE));
+        [self getCharacters:input range:block];
+        for (NSUInteger i = 0; i < block.length; i++)
         {
-            // convert newslines, tabs etc to spaces
-            [temp replaceCharactersInRange:NSMakeRange(i, 1) withString:@" "];
-
-            // was the last character also a space?
-            if ((i > 0) && ([temp characterAtIndex:i - 1] == ' '))
+            unichar character = input[i];
+            if ([whitespace characterIsMember:character])
+            {
+                // convert newlines, tabs etc to spaces, and drop any which follow a space
+                if (count > 0 && output[count - 1] == ' ')
+                    continue;
+                character = ' ';
+            }
+            if (count == capacity)
             {
-                // two consecutive whitespace characters, delete the second
-                [temp deleteCharactersInRange:NSMakeRange(i - 1, 1)];
-                i--;
-                length--;
+                // another character is due but the limit has been reached: no need to look at the rest of the receiver
+                truncated = YES;
+                break;
             }
+            output[count++] = character;
         }
     }
-    return [temp copy]; // return immutable
+    if (didTruncate) *didTruncate = truncated;
+    NSString *collapsed = [NSString stringWithCharacters:output length:count];
+    free(output);
+    return collapsed;
 }
 
 - (NSString *)WOTest_stringByAppendingCharacter:(unichar)character
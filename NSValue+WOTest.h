@@ -48,6 +48,58 @@
 #define WO_COMPARE_SCALARS(a, b) \
 ((a) == (b) ? NSOrderedSame : ((a) < (b) ? NSOrderedAscending : NSOrderedDescending))
 
+#pragma mark -
+#pragma mark Type descriptors
+
+/*! The kinds of type encoding distinguished by WOTest. */
+typedef enum WOTestTypeKind {
+    WOTestInvalidType = 0,                  //!< not a type encoding that WOTest understands
+    WOTestCharType,
+    WOTestIntType,
+    WOTestShortType,
+    WOTestLongType,
+    WOTestLongLongType,
+    WOTestUnsignedCharType,
+    WOTestUnsignedIntType,
+    WOTestUnsignedShortType,
+    WOTestUnsignedLongType,
+    WOTestUnsignedLongLongType,
+    WOTestFloatType,
+    WOTestDoubleType,
+    WOTestC99BoolType,
+    WOTestVoidType,
+    WOTestConstantCharacterStringType,
+    WOTestCharacterStringType,
+    WOTestObjectType,
+    WOTestClassType,
+    WOTestSelectorType,
+    WOTestPointerToVoidType,
+    WOTestPointerType,                      //!< any pointer other than a pointer to void
+    WOTestArrayType,
+    WOTestStructType,
+    WOTestUnionType,
+    WOTestBitfieldType,
+    WOTestUnknownType                       //!< "?" (for example, function pointers)
+} WOTestTypeKind;
+
+/*! A parsed type encoding. Descriptors are built once for each distinct encoding, never freed, and may be shared between threads. */
+typedef struct WOTestTypeDescriptor {
+    const char                          *encoding;          //!< the descriptor's own copy of the encoding
+    WOTestTypeKind                      kind;
+    BOOL                                isNumericScalar;
+    BOOL                                hasSize;            //!< NO if the size can't be determined
+    size_t                              size;               //!< as returned by WOTest_sizeForType:
+    BOOL                                hasAlignment;       //!< NO if the type can't be embedded in a struct, union or array
+    size_t                              alignment;          //!< as returned by WOTest_maximumEmbeddedSizeForType:
+    unsigned                            count;              //!< number of elements (arrays) or members (structs and unions)
+    const struct WOTestTypeDescriptor   *elementType;       //!< element type (arrays) or type pointed to (pointers)
+    const struct WOTestTypeDescriptor   **memberTypes;      //!< structs and unions
+    size_t                              *memberOffsets;     //!< structs (all zero for unions)
+} WOTestTypeDescriptor;
+
+/*! Returns the descriptor for the type encoding \p encoding (as returned by \@encode() or the objCType method), parsing it only if it has not been seen before. Repeated lookups of the same encoding on the same thread are answered from a per-thread cache without locking. Never returns NULL; encodings which can't be parsed yield a descriptor of kind WOTestInvalidType. */
+const WOTestTypeDescriptor *WOTestDescriptorForType(const char *encoding);
+
 /*! This category adds unit testing methods to the NSValue class. It provides methods for comparing NSValue objects for equality/non-equality and ordering.
 
 The base NSValue class adopts a stricter view of equality that makes it hard to compare numeric scalar values (char, int, short, long, long long, unsigned char, unsigned int, unsigned short, unsigned long, unsigned long long, float, double and C99 _Bool) because those values must be of the same type or class. For example, an NSValue that contains an int (10) and another that contains a long (10) would be considered unequal according the default implementation of the isEqualTo: method because they are not of the same type. Likewise an NSValue containing an NSMutableString (@"string") and another containing an NSString (@"string") would also be considered unequal because they are of different classes.
@@ -129,6 +181,9 @@ Class objects, method selectors (SEL), void types, character strings (char *), a
 /*! This method returns the minimum buffer size required to safely store an object of the type represented by \p typeString. Because it is impossible to know if any compiler pragmas or flags were used to change the default alignment behaviour of composite  types (structs, arrays, unions), this method bases its calculations on the space that would be required if the least-packed alignment were chosen. As such the values returned by this function may be greater than or equal to those returned by the sizeof compiler directive, but never less than. Throws an exception if \p typeString is nil. */
 + (size_t)WOTest_sizeForType:(NSString *)typeString;
 
+/*! Like WOTest_sizeForType: but takes the type encoding as a C string, avoiding the creation of an NSString. Throws an exception if the size can't be determined. */
++ (size_t)WOTest_sizeForObjCType:(const char *)type;
+
 /*! Returns YES if \p typeString contains a numeric scalar value (char, int, short, long, long long, unsigned char, unsigned int, unsigned short, unsigned long, unsigned long long, float, double, C99 _Bool). Returns NO if the receiver contains any other type, object or pointer (id, Class, SEL, void, char *, as well as arrays, structures and pointers). */
 + (BOOL)WOTest_typeIsNumericScalar:(NSString *)typeString;
 
@@ -552,6 +607,9 @@ Table corresponds to the warnings produced by the version of GCC 4.0 that ships
 /*! Returns the Objective-C type of the receiver as an NSString. */
 - (NSString *)WOTest_objCTypeString;
 
+/*! Returns the (cached) descriptor for the Objective-C type of the receiver. */
+- (const WOTestTypeDescriptor *)WOTest_typeDescriptor;
+
 /*! Returns a human-readable description of the receiver. */
 - (NSString *)WOTest_description;
 
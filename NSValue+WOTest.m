@@ -24,6 +24,7 @@
 
 // system headers
 #import <objc/objc-runtime.h>
+#import <pthread.h>
 
 // framework headers
 #import "WOTest.h"
@@ -31,6 +32,412 @@
 #import "NSScanner+WOTest.h"
 #import "NSString+WOTest.h"
 
+#pragma mark -
+#pragma mark Type descriptors
+
+// descriptors keyed by the contents of their encodings (so lookups don't depend on the address of the encoding passed in)
+static CFMutableDictionaryRef   WOTypeDescriptors       = NULL;
+static pthread_mutex_t          WOTypeDescriptorsMutex  = PTHREAD_MUTEX_INITIALIZER;
+
+// in front of the shared table each thread keeps a small direct-mapped cache keyed by the address of the encoding, so that
+// repeated lookups of the same @encode() string neither hash it nor take the lock
+#define WO_TYPE_CACHE_SIZE  32
+
+typedef struct WOTypeCacheEntry {
+    const char                  *encoding;
+    const WOTestTypeDescriptor  *descriptor;
+} WOTypeCacheEntry;
+
+static pthread_key_t            WOTypeCacheKey;
+static pthread_once_t           WOTypeCacheOnce         = PTHREAD_ONCE_INIT;
+
+static void WOTypeCacheCreateKey(void)
+{
+    pthread_key_create(&WOTypeCacheKey, free);
+}
+
+static inline WOTypeCacheEntry *WOTypeCacheEntryForEncoding(const char *encoding)
+{
+    pthread_once(&WOTypeCacheOnce, WOTypeCacheCreateKey);
+    WOTypeCacheEntry *cache = pthread_getspecific(WOTypeCacheKey);
+    if (!cache)
+    {
+        cache = calloc(WO_TYPE_CACHE_SIZE, sizeof(WOTypeCacheEntry));
+        NSCAssert(cache != NULL, @"calloc() failed");
+        pthread_setspecific(WOTypeCacheKey, cache);
+    }
+    uintptr_t address = (uintptr_t)encoding;
+    return &cache[(address ^ (address >> 5)) % WO_TYPE_CACHE_SIZE];
+}
+
+static CFHashCode WOTypeEncodingHash(const void *value)
+{
+    // FNV-1a
+    CFHashCode hash = 2166136261U;
+    for (const unsigned char *c = value; *c; c++)
+        hash = (hash ^ *c) * 16777619U;
+    return hash;
+}
+
+static Boolean WOTypeEncodingEqual(const void *value1, const void *value2)
+{
+    return (strcmp(value1, value2) == 0);
+}
+
+// returns the size of a non-compound type when embedded in a struct, union or array (0 if unsupported); the alignments and
+// embedding rules are taken from Apple's "Mac OS X ABI Function Call Guide"
+static size_t WOEmbeddedSizeForKind(WOTestTypeKind kind)
+{
+    switch (kind)
+    {
+#if defined (__i386__)
+        case WOTestC99BoolType:
+        case WOTestUnsignedCharType:
+        case WOTestCharType:
+            return 1;   // scalars of size/alignment 1
+        case WOTestUnsignedShortType:
+        case WOTestShortType:
+            return 2;   // scalars of size/alignment 2
+        case WOTestUnsignedIntType:
+        case WOTestIntType:
+        case WOTestUnsignedLongType:
+        case WOTestLongType:
+        case WOTestFloatType:
+            return 4;   // scalars of size/alignment 4
+        case WOTestUnsignedLongLongType:
+        case WOTestLongLongType:
+        case WOTestDoubleType:
+            return 8;   // scalars of size/alignment 8
+        case WOTestPointerType:
+        case WOTestPointerToVoidType:
+        case WOTestObjectType:
+        case WOTestClassType:
+        case WOTestSelectorType:
+        case WOTestCharacterStringType:
+        case WOTestConstantCharacterStringType:
+            return 4;   // pointers (size/alignment 4)
+        default:
+            // documented in "Mac OS X ABI Function Call Guide" but not supported:
+            // long double        16 bytes
+            // vector (64 bits)   8 bytes
+            // vector (128 bits)  16 bytes
+            return 0;
+#elif defined (__ppc__)
+        case WOTestUnsignedCharType:
+        case WOTestCharType:
+            return 1;   // scalars of size/alignment 1
+        case WOTestUnsignedShortType:
+        case WOTestShortType:
+            return 2;   // scalars of size/alignment 2
+        case WOTestC99BoolType:
+        case WOTestUnsignedIntType:
+        case WOTestIntType:
+        case WOTestUnsignedLongType:
+        case WOTestLongType:
+        case WOTestFloatType:
+            return 4;   // scalars of size/alignment 4
+        case WOTestUnsignedLongLongType:
+        case WOTestLongLongType:
+        case WOTestDoubleType:
+            return 8;   // scalars of size/alignment 8
+        case WOTestPointerType:
+        case WOTestPointerToVoidType:
+        case WOTestObjectType:
+        case WOTestClassType:
+        case WOTestSelectorType:
+        case WOTestCharacterStringType:
+        case WOTestConstantCharacterStringType:
+            return 4;   // pointers (size/alignment 4)
+        default:
+            // documented in "Mac OS X ABI Function Call Guide" but not supported:
+            // long double  8 bytes (Mac OS X < 10.4, GCC < 4.0)
+            // long double  16 bytes (Mac OS X >= 10.4, GCC >= 4.0)
+            // vector       16 bytes
+            return 0;
+#elif defined (__ppc64__)
+        case WOTestC99BoolType:
+        case WOTestUnsignedCharType:
+        case WOTestCharType:
+            return 1;   // scalars of size/alignment 1
+        case WOTestUnsignedShortType:
+        case WOTestShortType:
+            return 2;   // scalars of size/alignment 2
+        case WOTestUnsignedIntType:
+        case WOTestIntType:
+        case WOTestFloatType:
+            return 4;   // scalars of size/alignment 4
+        case WOTestUnsignedLongType:
+        case WOTestLongType:
+        case WOTestUnsignedLongLongType:
+        case WOTestLongLongType:
+        case WOTestDoubleType:
+            return 8;   // scalars of size/alignment 8
+        case WOTestPointerType:
+        case WOTestPointerToVoidType:
+        case WOTestObjectType:
+        case WOTestClassType:
+        case WOTestSelectorType:
+        case WOTestCharacterStringType:
+        case WOTestConstantCharacterStringType:
+            return 8;   // pointers (size/alignment 8)
+        default:
+            // documented in "Mac OS X ABI Function Call Guide" but not supported:
+            // long double  16 bytes
+            // vector       16 bytes
+            return 0;
+#else
+#error Unsupported architecture
+#endif
+    }
+}
+
+static void WOSetSimpleType(WOTestTypeDescriptor *descriptor, WOTestTypeKind kind, size_t size, BOOL isNumericScalar)
+{
+    descriptor->kind            = kind;
+    descriptor->size            = size;
+    descriptor->hasSize         = YES;
+    descriptor->isNumericScalar = isNumericScalar;
+}
+
+// scans the members of a struct or union (up to, but not including, the closing marker), returning NO on error
+static BOOL WOScanMemberTypes(NSScanner *scanner, WOTestTypeDescriptor *descriptor)
+{
+    NSMutableArray *members = [NSMutableArray array];
+    NSString *memberType;
+    while ([scanner WOTest_scanTypeIntoString:&memberType])
+        [members addObject:memberType];
+    descriptor->count           = [members count];
+    descriptor->memberTypes     = calloc(descriptor->count + 1, sizeof(WOTestTypeDescriptor *));
+    descriptor->memberOffsets   = calloc(descriptor->count + 1, sizeof(size_t));
+    NSCAssert(descriptor->memberTypes && descriptor->memberOffsets, @"calloc() failed");
+    BOOL valid = YES;
+    for (unsigned i = 0; i < descriptor->count; i++)
+    {
+        descriptor->memberTypes[i] = WOTestDescriptorForType([[members objectAtIndex:i] UTF8String]);
+        if (!descriptor->memberTypes[i]->hasAlignment)
+            valid = NO;
+    }
+    return valid;
+}
+
+static void WOParseCompoundType(WOTestTypeDescriptor *descriptor)
+{
+    NSString    *typeString = [NSString stringWithUTF8String:descriptor->encoding];
+    NSString    *pointer;
+    unichar     startMarker, endMarker;
+    if ([[NSScanner scannerWithString:typeString] scanPointerIntoString:&pointer])
+    {
+        WOSetSimpleType(descriptor, WOTestPointerType, sizeof(void *), NO);
+        descriptor->elementType = WOTestDescriptorForType([[pointer substringFromIndex:1] UTF8String]);
+    }
+    else if ([[NSScanner scannerWithString:typeString] WOTest_scanArrayIntoString:nil])
+    {
+        descriptor->kind = WOTestArrayType;
+        NSScanner   *scanner = [NSScanner scannerWithString:typeString];
+        int         count;
+        NSString    *elementType;
+        if ([scanner WOTest_scanCharacter:&startMarker] && (startMarker == _C_ARY_B) && [scanner scanInt:&count] &&
+            [scanner WOTest_scanTypeIntoString:&elementType] &&
+            [scanner WOTest_scanCharacter:&endMarker] && (endMarker == _C_ARY_E) && [scanner isAtEnd])
+        {
+            descriptor->count       = (unsigned)count;
+            descriptor->elementType = WOTestDescriptorForType([elementType UTF8String]);
+            descriptor->hasSize     = descriptor->elementType->hasSize;
+            descriptor->size        = descriptor->elementType->size * count;
+        }
+    }
+    else if ([[NSScanner scannerWithString:typeString] WOTest_scanStructIntoString:nil])
+    {
+        descriptor->kind = WOTestStructType;
+        NSScanner *scanner = [NSScanner scannerWithString:typeString];
+        if ([scanner WOTest_scanCharacter:&startMarker] && (startMarker == _C_STRUCT_B))
+        {
+            // scan optional identifier
+            if ([scanner WOTest_scanIdentifierIntoString:nil])
+                [scanner WOTest_scanCharacter:NULL]; // scan past "="
+
+            BOOL    valid           = WOScanMemberTypes(scanner, descriptor);
+            size_t  size            = 0;
+            size_t  largestMember   = 0;
+            for (unsigned i = 0; valid && i < descriptor->count; i++)
+            {
+                size_t memberSize = descriptor->memberTypes[i]->alignment;
+                largestMember = MAX(largestMember, memberSize);
+
+                if (memberSize != 0) // watch out for division by zero
+                {
+                    // check for alignment gap
+                    size_t modulo = (size % memberSize);
+                    if (modulo != 0) // fill alignment gap
+                        size += (memberSize - modulo);
+                }
+
+                descriptor->memberOffsets[i] = size;
+                size += memberSize;
+            }
+
+#if defined (__i386__) || defined (__ppc64)
+
+            // Special rules for i386:
+            // 1. Composite data types (structs/arrays/unions) take on the alignment of the member with the highest alignment
+            // 2. Size of composite type is a multiple of its alignment
+
+            // Special rules for ppc64 (equivalent):
+            // 1. Embedding alignment of composite types (array/struct) is same as largest embedding align of members.
+            // 2. Total size of the composite is rounded up to multiple of its embedding alignment.
+
+            // Special rules for ppc: None.
+
+            if (largestMember != 0) // watch out for division by zero
+            {
+                // check for alignment gap
+                size_t modulo = (size % largestMember);
+                if (modulo != 0) // fill alignment gap
+                    size += (largestMember - modulo);
+            }
+
+#endif
+
+            if (valid && [scanner WOTest_scanCharacter:&endMarker] && (endMarker == _C_STRUCT_E) && [scanner isAtEnd])
+            {
+                descriptor->size    = size;
+                descriptor->hasSize = YES;
+            }
+        }
+    }
+    else if ([[NSScanner scannerWithString:typeString] WOTest_scanUnionIntoString:nil])
+    {
+        descriptor->kind = WOTestUnionType;
+        NSScanner *scanner = [NSScanner scannerWithString:typeString];
+        if ([scanner WOTest_scanCharacter:&startMarker] && (startMarker == _C_UNION_B))
+        {
+            // scan optional identifier
+            if ([scanner WOTest_scanIdentifierIntoString:nil])
+                [scanner WOTest_scanCharacter:NULL]; // scan past "="
+
+            // size of union is size of largest type in the union
+            BOOL    valid   = WOScanMemberTypes(scanner, descriptor);
+            size_t  size    = 0;
+            for (unsigned i = 0; valid && i < descriptor->count; i++)
+                size = MAX(size, descriptor->memberTypes[i]->alignment);
+
+            if (valid && [scanner WOTest_scanCharacter:&endMarker] && (endMarker == _C_UNION_E) && [scanner isAtEnd])
+            {
+                descriptor->size    = size;
+                descriptor->hasSize = YES;
+            }
+        }
+    }
+    else if ([[NSScanner scannerWithString:typeString] WOTest_scanBitfieldIntoString:nil])
+        WOSetSimpleType(descriptor, WOTestBitfieldType, sizeof(int), NO);
+}
+
+static WOTestTypeDescriptor *WOBuildTypeDescriptor(const char *encoding)
+{
+    WOTestTypeDescriptor *descriptor = calloc(1, sizeof(WOTestTypeDescriptor));
+    NSCAssert(descriptor != NULL, @"calloc() failed");
+    descriptor->encoding = strdup(encoding);
+    NSCAssert(descriptor->encoding != NULL, @"strdup() failed");
+
+    if (strlen(encoding) == 1)
+    {
+        switch (*encoding)
+        {
+            case _C_CHR:        WOSetSimpleType(descriptor, WOTestCharType,             sizeof(char),               YES);   break;
+            case _C_INT:        WOSetSimpleType(descriptor, WOTestIntType,              sizeof(int),                YES);   break;
+            case _C_SHT:        WOSetSimpleType(descriptor, WOTestShortType,            sizeof(short),              YES);   break;
+            case _C_LNG:        WOSetSimpleType(descriptor, WOTestLongType,             sizeof(long),               YES);   break;
+            case _C_LNGLNG:     WOSetSimpleType(descriptor, WOTestLongLongType,         sizeof(long long),          YES);   break;
+            case _C_UCHR:       WOSetSimpleType(descriptor, WOTestUnsignedCharType,     sizeof(unsigned char),      YES);   break;
+            case _C_UINT:       WOSetSimpleType(descriptor, WOTestUnsignedIntType,      sizeof(unsigned int),       YES);   break;
+            case _C_USHT:       WOSetSimpleType(descriptor, WOTestUnsignedShortType,    sizeof(unsigned short),     YES);   break;
+            case _C_ULNG:       WOSetSimpleType(descriptor, WOTestUnsignedLongType,     sizeof(unsigned long),      YES);   break;
+            case _C_ULNGLNG:    WOSetSimpleType(descriptor, WOTestUnsignedLongLongType, sizeof(unsigned long long), YES);   break;
+            case _C_FLT:        WOSetSimpleType(descriptor, WOTestFloatType,            sizeof(float),              YES);   break;
+            case _C_DBL:        WOSetSimpleType(descriptor, WOTestDoubleType,           sizeof(double),             YES);   break;
+            case _C_99BOOL:     WOSetSimpleType(descriptor, WOTestC99BoolType,          sizeof(_Bool),              YES);   break;
+            case _C_VOID:       WOSetSimpleType(descriptor, WOTestVoidType,             sizeof(void),               NO);    break;
+            case _C_CHARPTR:    WOSetSimpleType(descriptor, WOTestCharacterStringType,  sizeof(char *),             NO);    break;
+            case _C_ID:         WOSetSimpleType(descriptor, WOTestObjectType,           sizeof(id),                 NO);    break;
+            case _C_CLASS:      WOSetSimpleType(descriptor, WOTestClassType,            sizeof(Class),              NO);    break;
+            case _C_SEL:        WOSetSimpleType(descriptor, WOTestSelectorType,         sizeof(SEL),                NO);    break;
+            case _C_UNDEF:      descriptor->kind = WOTestUnknownType;   break;  // could be a function pointer, or something else
+            default:            break;
+        }
+    }
+    else if (strcmp(encoding, "r*") == 0)
+        WOSetSimpleType(descriptor, WOTestConstantCharacterStringType, sizeof(const char *), NO);
+    else if (strcmp(encoding, "^v") == 0)
+    {
+        WOSetSimpleType(descriptor, WOTestPointerToVoidType, sizeof(void *), NO);
+        descriptor->elementType = WOTestDescriptorForType("v");
+    }
+
+    if (descriptor->kind == WOTestInvalidType)
+        WOParseCompoundType(descriptor);
+
+    // compound types are embedded at their full size
+    if (descriptor->kind == WOTestStructType || descriptor->kind == WOTestUnionType || descriptor->kind == WOTestArrayType)
+        descriptor->alignment = descriptor->size;
+    else if (descriptor->kind == WOTestBitfieldType)
+        descriptor->alignment = sizeof(int);
+    else
+        descriptor->alignment = WOEmbeddedSizeForKind(descriptor->kind);
+    descriptor->hasAlignment = (descriptor->alignment != 0 || (descriptor->hasSize && descriptor->size == 0));
+    return descriptor;
+}
+
+static void WOFreeTypeDescriptor(WOTestTypeDescriptor *descriptor)
+{
+    free((void *)descriptor->encoding);
+    free(descriptor->memberTypes);
+    free(descriptor->memberOffsets);
+    free(descriptor);
+}
+
+const WOTestTypeDescriptor *WOTestDescriptorForType(const char *encoding)
+{
+    NSCParameterAssert(encoding != NULL);
+
+    // an address can be reused for a different encoding (the objCType of a value which has since been freed, say), so a hit
+    // is confirmed against the contents too
+    WOTypeCacheEntry *entry = WOTypeCacheEntryForEncoding(encoding);
+    if (entry->encoding == encoding && strcmp(encoding, entry->descriptor->encoding) == 0)
+        return entry->descriptor;
+
+    pthread_mutex_lock(&WOTypeDescriptorsMutex);
+    if (!WOTypeDescriptors)
+    {
+        CFDictionaryKeyCallBacks keyCallBacks = { 0, NULL, NULL, NULL, WOTypeEncodingEqual, WOTypeEncodingHash };
+        WOTypeDescriptors = CFDictionaryCreateMutable(NULL, 0, &keyCallBacks, NULL);
+    }
+    const WOTestTypeDescriptor *descriptor = CFDictionaryGetValue(WOTypeDescriptors, encoding);
+    pthread_mutex_unlock(&WOTypeDescriptorsMutex);
+    if (descriptor)
+    {
+        entry->encoding     = encoding;
+        entry->descriptor   = descriptor;
+        return descriptor;
+    }
+
+    // parse without holding the lock because parsing a compound type looks up the descriptors for its members
+    WOTestTypeDescriptor *parsed = WOBuildTypeDescriptor(encoding);
+    pthread_mutex_lock(&WOTypeDescriptorsMutex);
+    descriptor = CFDictionaryGetValue(WOTypeDescriptors, encoding);
+    if (!descriptor)
+    {
+        CFDictionarySetValue(WOTypeDescriptors, parsed->encoding, parsed);
+        descriptor = parsed;
+        parsed = NULL;
+    }
+    pthread_mutex_unlock(&WOTypeDescriptorsMutex);
+    if (parsed) // another thread got there first
+        WOFreeTypeDescriptor(parsed);
+    entry->encoding     = encoding;
+    entry->descriptor   = descriptor;
+    return descriptor;
+}
+
 @implementation NSValue (WOTest)
 
 #pragma mark -
@@ -129,496 +536,208 @@
 #pragma mark -
 #pragma mark Parsing type strings
 
-// TODO: investigate whether NSGetSizeAndAlignment() could save some code here...
 + (size_t)WOTest_maximumEmbeddedSizeForType:(NSString *)typeString
 {
     NSParameterAssert(typeString != nil);
-    size_t size = 16; // worst case scenario
-
-    if ([self WOTest_typeIsCompound:typeString])
-        return [self WOTest_sizeForType:typeString];
-
-    if ([self WOTest_typeIsBitfield:typeString])
-        return sizeof(int);
-
-#if defined (__i386__)
-
-    if ([self WOTest_typeIsC99Bool:typeString]                         ||
-        [self WOTest_typeIsUnsignedChar:typeString]                    ||
-        [self WOTest_typeIsChar:typeString]                            ||
-        [self WOTest_typeIsUnsignedChar:typeString])
-        size = 1;   // scalars of size/alignment 1
-    else if ([self WOTest_typeIsUnsignedShort:typeString]              ||
-             [self WOTest_typeIsShort:typeString])
-        size = 2;   // scalars of size/alignment 2
-    else if ([self WOTest_typeIsUnsignedInt:typeString]                ||
-             [self WOTest_typeIsInt:typeString]                        ||
-             [self WOTest_typeIsUnsignedLong:typeString]               ||
-             [self WOTest_typeIsLong:typeString]                       ||
-             [self WOTest_typeIsFloat:typeString])
-        size = 4;   // scalars of size/alignment 4
-    else if ([self WOTest_typeIsUnsignedLongLong:typeString]           ||
-             [self WOTest_typeIsLongLong:typeString]                   ||
-             [self WOTest_typeIsDouble:typeString])
-        size = 8;   // scalars of size/alignment 8
-    else if ([self WOTest_typeIsPointer:typeString]                    ||
-             [self WOTest_typeIsPointerToVoid:typeString]              ||
-             [self WOTest_typeIsObject:typeString]                     ||
-             [self WOTest_typeIsClass:typeString]                      ||
-             [self WOTest_typeIsSelector:typeString]                   ||
-             [self WOTest_typeIsCharacterString:typeString]            ||
-             [self WOTest_typeIsConstantCharacterString:typeString])
-        size = 4;   // pointers (size/alignment 4)
-    else
-        // documented in "Mac OS X ABI Function Call Guide" but not supported:
-        // long double        16 bytes
-        // vector (64 bits)   8 bytes
-        // vector (128 bits)  16 bytes
-        [NSException raise:NSInternalInconsistencyException
-                    format:@"Type %@ not supported by WOTest_maximumEmbeddedSizeForType:", typeString];
-
-#elif defined (__ppc__)
-
-    if ([self WOTest_typeIsUnsignedChar:typeString]                    ||
-        [self WOTest_typeIsChar:typeString])
-        size = 1;   // scalars of size/alignment 1
-    else if ([self WOTest_typeIsUnsignedShort:typeString]              ||
-             [self WOTest_typeIsShort:typeString])
-        size = 2;   // scalars of size/alignment 2
-    else if ([self WOTest_typeIsC99Bool:typeString]                    ||
-             [self WOTest_typeIsUnsignedInt:typeString]                ||
-             [self WOTest_typeIsInt:typeString]                        ||
-             [self WOTest_typeIsUnsignedLong:typeString]               ||
-             [self WOTest_typeIsLong:typeString]                       ||
-             [self WOTest_typeIsFloat:typeString])
-        size = 4;   // scalars of size/alignment 4
-    else if ([self WOTest_typeIsUnsignedLongLong:typeString]           ||
-             [self WOTest_typeIsLongLong:typeString]                   ||
-             [self WOTest_typeIsDouble:typeString])
-        size = 8;   // scalars of size/alignment 8
-    else if ([self WOTest_typeIsPointer:typeString]                    ||
-             [self WOTest_typeIsPointerToVoid:typeString]              ||
-             [self WOTest_typeIsObject:typeString]                     ||
-             [self WOTest_typeIsClass:typeString]                      ||
-             [self WOTest_typeIsSelector:typeString]                   ||
-             [self WOTest_typeIsCharacterString:typeString]            ||
-             [self WOTest_typeIsConstantCharacterString:typeString])
-        size = 4;   // pointers (size/alignment 4)
-    else
-        // documented in "Mac OS X ABI Function Call Guide" but not supported:
-        // long double  8 bytes (Mac OS X < 10.4, GCC < 4.0)
-        // long double  16 bytes (Mac OS X >= 10.4, GCC >= 4.0)
-        // vector       16 bytes
-        [NSException raise:NSInternalInconsistencyException
-                    format:@"Type %@ not supported by WOTest_maximumEmbeddedSizeForType:", typeString];
-
-#elif defined (__ppc64__)
-
-    if ([self WOTest_typeIsC99Bool:typeString]                         ||
-        [self WOTest_typeIsUnsignedChar:typeString]                    ||
-        [self WOTest_typeIsChar:typeString])
-        size = 1;   // scalars of size/alignment 1
-    else if ([self WOTest_typeIsUnsignedShort:typeString]              ||
-             [self WOTest_typeIsShort:typeString])
-        size = 2;   // scalars of size/alignment 2
-    else if ([self WOTest_typeIsUnsignedInt:typeString]                ||
-             [self WOTest_typeIsInt:typeString]                        ||
-             [self WOTest_typeIsFloat:typeString])
-        size = 4;   // scalars of size/alignment 4
-    else if ([self WOTest_typeIsUnsignedLong:typeString]               ||
-             [self WOTest_typeIsLong:typeString]                       ||
-             [self WOTest_typeIsUnsignedLongLong:typeString]           ||
-             [self WOTest_typeIsLongLong:typeString]                   ||
-             [self WOTest_typeIsDouble:typeString])
-        size = 8;   // scalars of size/alignment 8
-    else if ([self WOTest_typeIsPointer:typeString]                    ||
-             [self WOTest_typeIsPointerToVoid:typeString]              ||
-             [self WOTest_typeIsObject:typeString]                     ||
-             [self WOTest_typeIsClass:typeString]                      ||
-             [self WOTest_typeIsSelector:typeString]                   ||
-             [self WOTest_typeIsCharacterString:typeString]            ||
-             [self WOTest_typeIsConstantCharacterString:typeString])
-        size = 8;   // pointers (size/alignment 8)
-    else
-        // documented in "Mac OS X ABI Function Call Guide" but not supported:
-        // long double  16 bytes
-        // vector       16 bytes
+    const WOTestTypeDescriptor *descriptor = WOTestDescriptorForType([typeString UTF8String]);
+    if (!descriptor->hasAlignment)
         [NSException raise:NSInternalInconsistencyException
                     format:@"Type %@ not supported by WOTest_maximumEmbeddedSizeForType:", typeString];
-
-#else
-
-#error Unsupported architecture
-
-#endif
-
-    return size;
+    return descriptor->alignment;
 }
 
 + (size_t)WOTest_sizeForType:(NSString *)typeString
 {
     NSParameterAssert(typeString != nil);
-    size_t size = 0;
-
-    if ([self WOTest_typeIsChar:typeString])
-        size = sizeof(char);
-    else if ([self WOTest_typeIsInt:typeString])
-        size = sizeof(int);
-    else if ([self WOTest_typeIsShort:typeString])
-        size = sizeof(short);
-    else if ([self WOTest_typeIsLong:typeString])
-        size = sizeof(long);
-    else if ([self WOTest_typeIsLongLong:typeString])
-        size = sizeof(long long);
-    else if ([self WOTest_typeIsUnsignedChar:typeString])
-        size = sizeof(unsigned char);
-    else if ([self WOTest_typeIsUnsignedInt:typeString])
-        size = sizeof(unsigned int);
-    else if ([self WOTest_typeIsUnsignedShort:typeString])
-        size = sizeof(unsigned short);
-    else if ([self WOTest_typeIsUnsignedLong:typeString])
-        size = sizeof(unsigned long);
-    else if ([self WOTest_typeIsUnsignedLongLong:typeString])
-        size = sizeof(unsigned long long);
-    else if ([self WOTest_typeIsFloat:typeString])
-        size = sizeof(float);
-    else if ([self WOTest_typeIsDouble:typeString])
-        size = sizeof(double);
-    else if ([self WOTest_typeIsC99Bool:typeString])
-        size = sizeof(_Bool);
-    else if ([self WOTest_typeIsVoid:typeString])
-        size = sizeof(void);
-    else if ([self WOTest_typeIsConstantCharacterString:typeString])
-        size = sizeof(const char *);
-    else if ([self WOTest_typeIsCharacterString:typeString])
-        size = sizeof(char *);
-    else if ([self WOTest_typeIsObject:typeString])
-        size = sizeof(id);
-    else if ([self WOTest_typeIsClass:typeString])
-        size = sizeof(Class);
-    else if ([self WOTest_typeIsSelector:typeString])
-        size = sizeof(SEL);
-    else if ([self WOTest_typeIsPointerToVoid:typeString])
-        size = sizeof(void *);
-    else // handle complex types and special cases
-    {
-        // if is pointer
-        if ([self WOTest_typeIsPointer:typeString])
-            size = sizeof(void *);
-        else if ([self WOTest_typeIsArray:typeString])
-        {
-            NSScanner *scanner = [NSScanner scannerWithString:typeString];
-            unichar startMarker, endMarker;
-            int count;
-            NSString *elementType;
-            if ([scanner WOTest_scanCharacter:&startMarker] &&
-                (startMarker == _C_ARY_B) && [scanner scanInt:&count] &&
-                [scanner WOTest_scanTypeIntoString:&elementType] &&
-                [scanner WOTest_scanCharacter:&endMarker] && (endMarker == _C_ARY_E) &&
-                [scanner isAtEnd])
-            {
-                // recursion
-                size = [self WOTest_sizeForType:elementType] * count;
-            }
-            else
-                [NSException raise:NSInternalInconsistencyException
-                            format:@"scanner error in sizeForType for type %@", typeString];
-        }
-        else if ([self WOTest_typeIsStruct:typeString])
-        {
-            NSScanner *scanner = [NSScanner scannerWithString:typeString];
-            unichar startMarker, endMarker;
-
-            if ([scanner WOTest_scanCharacter:&startMarker] &&
-                (startMarker == _C_STRUCT_B))
-            {
-                // scan optional identifier
-                if ([scanner WOTest_scanIdentifierIntoString:nil])
-                    [scanner WOTest_scanCharacter:NULL]; // scan past "="
-
-                NSString    *memberType;
-                size_t      largestMember   = 0;
-                while ([scanner WOTest_scanTypeIntoString:&memberType])
-                {
-                    size_t memberSize = [self WOTest_maximumEmbeddedSizeForType:memberType];
-                    largestMember = MAX(largestMember, memberSize);
-
-                    if (memberSize != 0) // watch out for division by zero
-                    {
-                        // check for alignment gap
-                        size_t modulo = (size % memberSize);
-                        if (modulo != 0) // fill alignment gap
-                            size += (memberSize - modulo);
-                    }
-
-                    size += memberSize;
-                }
-
-#if defined (__i386__) || defined (__ppc64)
-
-                // Special rules for i386:
-                // 1. Composite data types (structs/arrays/unions) take on the alignment of the member with the highest alignment
-                // 2. Size of composite type is a multiple of its alignment
-
-                // Special rules for ppc64 (equivalent):
-                // 1. Embedding alignment of composite types (array/struct) is same as largest embedding align of members.
-                // 2. Total size of the composite is rounded up to multiple of its embedding alignment.
-
-                // Special rules for ppc: None.
-
-                if (largestMember != 0) // watch out for division by zero
-                {
-                    // check for alignment gap
-                    size_t modulo = (size % largestMember);
-                    if (modulo != 0) // fill alignment gap
-                        size += (largestMember - modulo);
-                }
-
-#endif
-
-                if ([scanner WOTest_scanCharacter:&endMarker] && (endMarker == _C_STRUCT_E) && [scanner isAtEnd])
-                    return size; // all done
-            }
-
-            [NSException raise:NSInternalInconsistencyException format:@"scanner error in sizeForType for type %@", typeString];
-        }
-        else if ([self WOTest_typeIsUnion:typeString])
-        {
-            NSScanner *scanner = [NSScanner scannerWithString:typeString];
-            unichar startMarker, endMarker;
-
-            if ([scanner WOTest_scanCharacter:&startMarker] && (startMarker == _C_UNION_B))
-            {
-                // scan optional identifier
-                if ([scanner WOTest_scanIdentifierIntoString:nil])
-                    [scanner WOTest_scanCharacter:NULL]; // scan past "="
-
-                NSString *memberType;
-                while ([scanner WOTest_scanTypeIntoString:&memberType])
-                    // size of union is size of largest type in the union
-                    size = MAX(size, [self WOTest_maximumEmbeddedSizeForType:memberType]);
-
-                if ([scanner WOTest_scanCharacter:&endMarker] && (endMarker == _C_UNION_E) && [scanner isAtEnd])
-                    return size; // all done
-            }
+    return [self WOTest_sizeForObjCType:[typeString UTF8String]];
+}
 
-            [NSException raise:NSInternalInconsistencyException format:@"scanner error in sizeForType for type %@", typeString];
-        }
-        else if ([self WOTest_typeIsBitfield:typeString])
-            size = sizeof(int);
-        else if ([self WOTest_typeIsUnknown:typeString])
-        {
-            // could be a function pointer, but could be something else
-            [NSException raise:NSInternalInconsistencyException format: @"Cannot calculate buffer size for type %@", typeString];
-        }
-        else // we officially have no idea whatsoever
-            [NSException raise:NSInternalInconsistencyException
-                        format:@"Cannot calculate buffer size for unknown type %@", typeString];
-    }
++ (size_t)WOTest_sizeForObjCType:(const char *)type
+{
+    NSParameterAssert(type != NULL);
+    const WOTestTypeDescriptor *descriptor = WOTestDescriptorForType(type);
+    if (descriptor->hasSize)
+        return descriptor->size;
 
-    return size;
+    if (descriptor->kind == WOTestArrayType || descriptor->kind == WOTestStructType || descriptor->kind == WOTestUnionType)
+        [NSException raise:NSInternalInconsistencyException format:@"scanner error in sizeForType for type %s", type];
+    else if (descriptor->kind == WOTestUnknownType)
+        // could be a function pointer, but could be something else
+        [NSException raise:NSInternalInconsistencyException format:@"Cannot calculate buffer size for type %s", type];
+    else // we officially have no idea whatsoever
+        [NSException raise:NSInternalInconsistencyException format:@"Cannot calculate buffer size for unknown type %s", type];
+    return 0;
 }
 
 /*! Returns YES if \p typeString contains a numeric scalar value (char, int, short, long, long long, unsigned char, unsigned int, unsigned short, unsigned long, unsigned long long, float, double, C99 _Bool). Returns NO if the receiver contains any other type, object or pointer (id, Class, SEL, void, char *, as well as arrays, structures and pointers). */
 + (BOOL)WOTest_typeIsNumericScalar:(NSString *)typeString
 {
     if (!typeString) return NO;
-    return ([self WOTest_typeIsChar:typeString]                ||
-            [self WOTest_typeIsInt:typeString]                 ||
-            [self WOTest_typeIsShort:typeString]               ||
-            [self WOTest_typeIsLong:typeString]                ||
-            [self WOTest_typeIsLongLong:typeString]            ||
-            [self WOTest_typeIsUnsignedChar:typeString]        ||
-            [self WOTest_typeIsUnsignedInt:typeString]         ||
-            [self WOTest_typeIsUnsignedShort:typeString]       ||
-            [self WOTest_typeIsUnsignedLong:typeString]        ||
-            [self WOTest_typeIsUnsignedLongLong:typeString]    ||
-            [self WOTest_typeIsFloat:typeString]               ||
-            [self WOTest_typeIsDouble:typeString]              ||
-            [self WOTest_typeIsC99Bool:typeString]);
+    return WOTestDescriptorForType([typeString UTF8String])->isNumericScalar;
 }
 
 + (BOOL)WOTest_typeIsCompound:(NSString *)typeString
 {
     if (!typeString) return NO;
-    return ([self WOTest_typeIsStruct:typeString] || [self WOTest_typeIsUnion:typeString] || [self WOTest_typeIsArray:typeString]);
+    WOTestTypeKind kind = WOTestDescriptorForType([typeString UTF8String])->kind;
+    return (kind == WOTestStructType || kind == WOTestUnionType || kind == WOTestArrayType);
 }
 
 + (BOOL)WOTest_typeIsChar:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_CHR);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestCharType);
 }
 
 + (BOOL)WOTest_typeIsInt:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_INT);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestIntType);
 }
 
 + (BOOL)WOTest_typeIsShort:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_SHT);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestShortType);
 }
 
 + (BOOL)WOTest_typeIsLong:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_LNG);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestLongType);
 }
 
 + (BOOL)WOTest_typeIsLongLong:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_LNGLNG);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestLongLongType);
 }
 
 + (BOOL)WOTest_typeIsUnsignedChar:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_UCHR);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestUnsignedCharType);
 }
 
 + (BOOL)WOTest_typeIsUnsignedInt:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_UINT);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestUnsignedIntType);
 }
 
 + (BOOL)WOTest_typeIsUnsignedShort:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_USHT);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestUnsignedShortType);
 }
 
 + (BOOL)WOTest_typeIsUnsignedLong:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_ULNG);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestUnsignedLongType);
 }
 
 + (BOOL)WOTest_typeIsUnsignedLongLong:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_ULNGLNG);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestUnsignedLongLongType);
 }
 
 + (BOOL)WOTest_typeIsFloat:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_FLT);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestFloatType);
 }
 
 + (BOOL)WOTest_typeIsDouble:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_DBL);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestDoubleType);
 }
 
 + (BOOL)WOTest_typeIsC99Bool:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_99BOOL);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestC99BoolType);
 }
 
 + (BOOL)WOTest_typeIsVoid:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_VOID);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestVoidType);
 }
 
 + (BOOL)WOTest_typeIsConstantCharacterString:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 2) && (strcmp(type, "r*") == 0));
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestConstantCharacterStringType);
 }
 
 + (BOOL)WOTest_typeIsCharacterString:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_CHARPTR);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestCharacterStringType);
 }
 
 + (BOOL)WOTest_typeIsObject:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_ID);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestObjectType);
 }
 
 + (BOOL)WOTest_typeIsClass:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_CLASS);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestClassType);
 }
 
 + (BOOL)WOTest_typeIsSelector:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_SEL);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestSelectorType);
 }
 
 + (BOOL)WOTest_typeIsPointerToVoid:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 2) && (strcmp(type, "^v") == 0));
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestPointerToVoidType);
 }
 
 + (BOOL)WOTest_typeIsPointer:(NSString *)typeString
 {
-    NSScanner *scanner = [NSScanner scannerWithString:typeString];
-    return [scanner scanPointerIntoString:nil];
+    if (!typeString) return NO;
+    WOTestTypeKind kind = WOTestDescriptorForType([typeString UTF8String])->kind;
+    return (kind == WOTestPointerType || kind == WOTestPointerToVoidType);
 }
 
 + (BOOL)WOTest_typeIsArray:(NSString *)typeString
 {
-    NSScanner *scanner = [NSScanner scannerWithString:typeString];
-    return [scanner WOTest_scanArrayIntoString:nil];
+    if (!typeString) return NO;
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestArrayType);
 }
 
 + (BOOL)WOTest_typeIsStruct:(NSString *)typeString
 {
-    NSScanner *scanner = [NSScanner scannerWithString:typeString];
-    return [scanner WOTest_scanStructIntoString:nil];
+    if (!typeString) return NO;
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestStructType);
 }
 
 + (BOOL)WOTest_typeIsUnion:(NSString *)typeString
 {
-    NSScanner *scanner = [NSScanner scannerWithString:typeString];
-    return [scanner WOTest_scanUnionIntoString:nil];
+    if (!typeString) return NO;
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestUnionType);
 }
 
 + (BOOL)WOTest_typeIsBitfield:(NSString *)typeString
 {
-    NSScanner *scanner = [NSScanner scannerWithString:typeString];
-    return [scanner WOTest_scanBitfieldIntoString:nil];
+    if (!typeString) return NO;
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestBitfieldType);
 }
 
 + (BOOL)WOTest_typeIsUnknown:(NSString *)typeString
 {
     if (!typeString) return NO;
-    const char *type = [typeString UTF8String];
-    return ((strlen(type) == 1) && *type == _C_UNDEF);
+    return (WOTestDescriptorForType([typeString UTF8String])->kind == WOTestUnknownType);
 }
 
 #pragma mark -
@@ -767,33 +886,37 @@
     // numeric scalar case
     if ([self WOTest_isNumericScalar] && [aValue WOTest_isNumericScalar])
     {
-        if ([aValue WOTest_isChar])
-            return [self WOTest_compareWithChar:[aValue WOTest_charValue]];
-        else if ([aValue WOTest_isInt])
-            return [self WOTest_compareWithInt:[aValue WOTest_intValue]];
-        else if ([aValue WOTest_isShort])
-            return [self WOTest_compareWithShort:[aValue WOTest_shortValue]];
-        else if ([aValue WOTest_isLong])
-            return [self WOTest_compareWithLong:[aValue WOTest_longValue]];
-        else if ([aValue WOTest_isLongLong])
-            return [self WOTest_compareWithLongLong:[aValue WOTest_longLongValue]];
-        else if ([aValue WOTest_isUnsignedChar])
-            return [self WOTest_compareWithUnsignedChar:[aValue WOTest_unsignedCharValue]];
-        else if ([aValue WOTest_isUnsignedInt])
-            return [self WOTest_compareWithUnsignedInt:[aValue WOTest_unsignedIntValue]];
-        else if ([aValue WOTest_isUnsignedShort])
-            return [self WOTest_compareWithUnsignedShort:[aValue WOTest_unsignedShortValue]];
-        else if ([aValue WOTest_isUnsignedLong])
-            return [self WOTest_compareWithUnsignedLong:[aValue WOTest_unsignedLongValue]];
-        else if ([aValue WOTest_isUnsignedLongLong])
-            return [self WOTest_compareWithUnsignedLongLong:
-                [aValue WOTest_unsignedLongLongValue]];
-        else if ([aValue WOTest_isFloat])
-            return [self WOTest_compareWithFloat:[aValue WOTest_floatValue]];
-        else if ([aValue WOTest_isDouble])
-            return [self WOTest_compareWithDouble:[aValue WOTest_doubleValue]];
-        else if ([aValue WOTest_isC99Bool])
-            return [self WOTest_compareWithC99Bool:[aValue WOTest_C99BoolValue]];
+        switch ([aValue WOTest_typeDescriptor]->kind)
+        {
+            case WOTestCharType:
+                return [self WOTest_compareWithChar:[aValue WOTest_charValue]];
+            case WOTestIntType:
+                return [self WOTest_compareWithInt:[aValue WOTest_intValue]];
+            case WOTestShortType:
+                return [self WOTest_compareWithShort:[aValue WOTest_shortValue]];
+            case WOTestLongType:
+                return [self WOTest_compareWithLong:[aValue WOTest_longValue]];
+            case WOTestLongLongType:
+                return [self WOTest_compareWithLongLong:[aValue WOTest_longLongValue]];
+            case WOTestUnsignedCharType:
+                return [self WOTest_compareWithUnsignedChar:[aValue WOTest_unsignedCharValue]];
+            case WOTestUnsignedIntType:
+                return [self WOTest_compareWithUnsignedInt:[aValue WOTest_unsignedIntValue]];
+            case WOTestUnsignedShortType:
+                return [self WOTest_compareWithUnsignedShort:[aValue WOTest_unsignedShortValue]];
+            case WOTestUnsignedLongType:
+                return [self WOTest_compareWithUnsignedLong:[aValue WOTest_unsignedLongValue]];
+            case WOTestUnsignedLongLongType:
+                return [self WOTest_compareWithUnsignedLongLong:[aValue WOTest_unsignedLongLongValue]];
+            case WOTestFloatType:
+                return [self WOTest_compareWithFloat:[aValue WOTest_floatValue]];
+            case WOTestDoubleType:
+                return [self WOTest_compareWithDouble:[aValue WOTest_doubleValue]];
+            case WOTestC99BoolType:
+                return [self WOTest_compareWithC99Bool:[aValue WOTest_C99BoolValue]];
+            default:
+                break;
+        }
     }
 
     [NSException raise:NSInvalidArgumentException format:@"non-numeric value(s) passed"];
@@ -807,7 +930,7 @@
 
 - (size_t)WOTest_bufferSize
 {
-    return [[self class] WOTest_sizeForType:[self WOTest_objCTypeString]];
+    return [[self class] WOTest_sizeForObjCType:[self objCType]];
 }
 
 - (void)WOTest_printSignCompareWarning:(NSString *)warning
@@ -831,6 +954,12 @@
     return [NSString stringWithUTF8String:[self objCType]];
 }
 
+/*! Returns the interned descriptor for the Objective-C type of the receiver. */
+- (const WOTestTypeDescriptor *)WOTest_typeDescriptor
+{
+    return WOTestDescriptorForType([self objCType]);
+}
+
 - (NSString *)WOTest_description
 {
     // these special handlings exist because NSValue's description is not very human-friendly
@@ -918,69 +1047,57 @@
 
 - (BOOL)WOTest_isNumericScalar
 {
-    return ([self WOTest_isChar]           || [self WOTest_isInt]                 ||
-            [self WOTest_isShort]          || [self WOTest_isLong]                ||
-            [self WOTest_isLongLong]       || [self WOTest_isUnsignedChar]        ||
-            [self WOTest_isUnsignedInt]    || [self WOTest_isUnsignedShort]       ||
-            [self WOTest_isUnsignedLong]   || [self WOTest_isUnsignedLongLong]    ||
-            [self WOTest_isFloat]          || [self WOTest_isDouble]              ||
-            [self WOTest_isC99Bool]);
+    return [self WOTest_typeDescriptor]->isNumericScalar;
 }
 
 - (BOOL)WOTest_isPointer
 {
-    return [[self class] WOTest_typeIsPointer:[self WOTest_objCTypeString]];
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    return (kind == WOTestPointerType || kind == WOTestPointerToVoidType);
 }
 
 - (BOOL)WOTest_isArray
 {
-    return [[self class] WOTest_typeIsArray:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestArrayType);
 }
 
 - (unsigned)WOTest_arrayCount
 {
     NSAssert([self WOTest_isArray],
              @"WOTest_arrayCount sent but receiver does not contain an array");
-    NSScanner *scanner = [NSScanner scannerWithString:[self WOTest_objCTypeString]];
-    unichar startMarker;
-    int count = 0;
-
-    // attempt the scan: it should work
-    if (!([scanner WOTest_scanCharacter:&startMarker] && (startMarker == _C_ARY_B) && [scanner scanInt:&count]))
+    const WOTestTypeDescriptor *descriptor = [self WOTest_typeDescriptor];
+    if (!descriptor->elementType)
         [NSException raise:NSInternalInconsistencyException format:@"scanner error in WOTest_arrayCount"];
-
-    return (unsigned)count;
+    return descriptor->count;
 }
 
 - (NSString *)WOTest_arrayType
 {
     NSAssert([self WOTest_isArray], @"WOTest_arrayType sent but receiver does not contain an array");
-    NSScanner *scanner = [NSScanner scannerWithString:[self WOTest_objCTypeString]];
-    [scanner setScanLocation:1];
-    NSString *typeString;
-    if (!([scanner scanInt:nil] && [scanner WOTest_scanTypeIntoString:&typeString]))
+    const WOTestTypeDescriptor *descriptor = [self WOTest_typeDescriptor];
+    if (!descriptor->elementType)
         [NSException raise:NSInternalInconsistencyException format:@"scanner error in WOTest_arrayType"];
-    return typeString;
+    return [NSString stringWithUTF8String:descriptor->elementType->encoding];
 }
 
 - (BOOL)WOTest_isStruct
 {
-    return [[self class] WOTest_typeIsStruct:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestStructType);
 }
 
 - (BOOL)WOTest_isUnion
 {
-    return [[self class] WOTest_typeIsUnion:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestUnionType);
 }
 
 - (BOOL)WOTest_isBitfield
 {
-    return [[self class] WOTest_typeIsBitfield:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestBitfieldType);
 }
 
 - (BOOL)WOTest_isUnknown
 {
-    return [[self class] WOTest_typeIsUnknown:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestUnknownType);
 }
 
 #pragma mark -
@@ -988,102 +1105,102 @@
 
 - (BOOL)WOTest_isChar
 {
-    return [[self class] WOTest_typeIsChar:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestCharType);
 }
 
 - (BOOL)WOTest_isInt
 {
-    return [[self class] WOTest_typeIsInt:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestIntType);
 }
 
 - (BOOL)WOTest_isShort
 {
-    return [[self class] WOTest_typeIsShort:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestShortType);
 }
 
 - (BOOL)WOTest_isLong
 {
-    return [[self class] WOTest_typeIsLong:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestLongType);
 }
 
 - (BOOL)WOTest_isLongLong
 {
-    return [[self class] WOTest_typeIsLongLong:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestLongLongType);
 }
 
 - (BOOL)WOTest_isUnsignedChar
 {
-    return [[self class] WOTest_typeIsUnsignedChar:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestUnsignedCharType);
 }
 
 - (BOOL)WOTest_isUnsignedInt
 {
-    return [[self class] WOTest_typeIsUnsignedInt:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestUnsignedIntType);
 }
 
 - (BOOL)WOTest_isUnsignedShort
 {
-    return [[self class] WOTest_typeIsUnsignedShort:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestUnsignedShortType);
 }
 
 - (BOOL)WOTest_isUnsignedLong
 {
-    return [[self class] WOTest_typeIsUnsignedLong:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestUnsignedLongType);
 }
 
 - (BOOL)WOTest_isUnsignedLongLong
 {
-    return [[self class] WOTest_typeIsUnsignedLongLong:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestUnsignedLongLongType);
 }
 
 - (BOOL)WOTest_isFloat
 {
-    return [[self class] WOTest_typeIsFloat:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestFloatType);
 }
 
 - (BOOL)WOTest_isDouble
 {
-    return [[self class] WOTest_typeIsDouble:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestDoubleType);
 }
 
 - (BOOL)WOTest_isC99Bool
 {
-    return [[self class] WOTest_typeIsC99Bool:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestC99BoolType);
 }
 
 - (BOOL)WOTest_isVoid
 {
-    return [[self class] WOTest_typeIsVoid:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestVoidType);
 }
 
 - (BOOL)WOTest_isConstantCharacterString
 {
-    return [[self class] WOTest_typeIsConstantCharacterString:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestConstantCharacterStringType);
 }
 
 - (BOOL)WOTest_isCharacterString
 {
-    return [[self class] WOTest_typeIsCharacterString:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestCharacterStringType);
 }
 
 - (BOOL)WOTest_isObject
 {
-    return [[self class] WOTest_typeIsObject:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestObjectType);
 }
 
 - (BOOL)WOTest_isClass
 {
-    return [[self class] WOTest_typeIsClass:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestClassType);
 }
 
 - (BOOL)WOTest_isSelector
 {
-    return [[self class] WOTest_typeIsSelector:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestSelectorType);
 }
 
 - (BOOL)WOTest_isPointerToVoid
 {
-    return [[self class] WOTest_typeIsPointerToVoid:[self WOTest_objCTypeString]];
+    return ([self WOTest_typeDescriptor]->kind == WOTestPointerToVoidType);
 }
 
 - (char)WOTest_charValue
@@ -1221,15 +1338,10 @@
 
 - (BOOL)WOTest_isCharArray
 {
-    // look for string of form "[4c]"
-    NSScanner *scanner = [NSScanner scannerWithString:[self WOTest_objCTypeString]];
-    unichar startMarker, flag, endMarker;
-    int count;
-    return ([scanner WOTest_scanCharacter:&startMarker] && (startMarker == _C_ARY_B) &&
-            [scanner scanInt:&count] &&
-            [scanner WOTest_scanCharacter:&flag] && (flag == _C_CHR) &&
-            [scanner WOTest_scanCharacter:&endMarker] && (endMarker == _C_ARY_E) &&
-            [scanner isAtEnd]);
+    // look for type of form "[4c]"
+    const WOTestTypeDescriptor *descriptor = [self WOTest_typeDescriptor];
+    return ((descriptor->kind == WOTestArrayType) && descriptor->elementType &&
+            (descriptor->elementType->kind == WOTestCharType));
 }
 
 - (NSString *)WOTest_stringValue
@@ -1279,42 +1391,43 @@
 /* Unfortunately there is a lot of very similar code repeated across these methods but it seems to be a necessary evil (600 lines of necessary evil). Firstly, it's necessary to explicitly declare the type of the right-hand value of the comparison. There are lots of permuations for implicit casts, explicit casts (and warnings), and GCC seems to warn about signed to unsigned comparisons differently depending on the types. */
 - (NSComparisonResult)WOTest_compareWithChar:(char)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
         return WO_COMPARE_SCALARS([self WOTest_charValue], other); // no cast
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
         return WO_COMPARE_SCALARS([self WOTest_intValue], other); // implicit cast
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
         return WO_COMPARE_SCALARS([self WOTest_shortValue], other); // implicit cast
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
         return WO_COMPARE_SCALARS([self WOTest_longValue], other); // implicit cast
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
         // implicit cast
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other);
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedIntValue], (unsigned char)other); // explicit cast
     }
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], (unsigned char)other); // explicit cast
     }
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         // explicit cast
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], (unsigned char)other);
     }
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
          return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1326,41 +1439,42 @@
 
 - (NSComparisonResult)WOTest_compareWithInt:(int)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
         return WO_COMPARE_SCALARS([self WOTest_charValue], other); // implicit cast
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
         return WO_COMPARE_SCALARS([self WOTest_intValue], other); // no cast
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
         return WO_COMPARE_SCALARS([self WOTest_shortValue], other); // implicit cast
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
         return WO_COMPARE_SCALARS([self WOTest_longValue], other); // implicit cast
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
                                     // implicit cast
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other);
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedIntValue], (unsigned int)other); // explicit cast
     }
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], (unsigned int)other); // explicit cast
     }
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], (unsigned int)other);  // explicit cast
     }
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1372,41 +1486,42 @@
 
 - (NSComparisonResult)WOTest_compareWithShort:(short)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
         return WO_COMPARE_SCALARS([self WOTest_charValue], other); // implicit cast
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
         return WO_COMPARE_SCALARS([self WOTest_intValue], other); // implicit cast
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
         return WO_COMPARE_SCALARS([self WOTest_shortValue], other); // no cast
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
         return WO_COMPARE_SCALARS([self WOTest_longValue], other); // implicit cast
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
                                     // implicit cast
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other);
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedIntValue], (unsigned short)other); // explicit cast
     }
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], (unsigned short)other); // explicit cast
     }
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], (unsigned short)other);  // explicit cast
     }
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1418,42 +1533,43 @@
 
 - (NSComparisonResult)WOTest_compareWithLong:(long)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
         return WO_COMPARE_SCALARS([self WOTest_charValue], other); // implicit cast
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
         return WO_COMPARE_SCALARS([self WOTest_intValue], other); // implicit cast
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
         return WO_COMPARE_SCALARS([self WOTest_shortValue], other); // implicit cast
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
         return WO_COMPARE_SCALARS([self WOTest_longValue], other); // no cast
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
                                     // implicit cast
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other);
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedIntValue], (unsigned long)other); // explicit cast
     }
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], (unsigned long)other); // explicit cast
     }
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         // explicit cast
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], (unsigned long)other);
     }
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1465,34 +1581,35 @@
 
 - (NSComparisonResult)WOTest_compareWithLongLong:(long long)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
         return WO_COMPARE_SCALARS([self WOTest_charValue], other); // implicit cast
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
         return WO_COMPARE_SCALARS([self WOTest_intValue], other); // implicit cast
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
         return WO_COMPARE_SCALARS([self WOTest_shortValue], other); // implicit cast
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
         return WO_COMPARE_SCALARS([self WOTest_longValue], other); // implicit cast
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // no cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
         return WO_COMPARE_SCALARS ([self WOTest_unsignedIntValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], (unsigned long long)other);  // explicit cast
     }
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1504,31 +1621,32 @@
 
 - (NSComparisonResult)WOTest_compareWithUnsignedChar:(unsigned char)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
         return WO_COMPARE_SCALARS([self WOTest_charValue], other); // implicit cast
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
         return WO_COMPARE_SCALARS([self WOTest_intValue], other); // implicit cast
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
         return WO_COMPARE_SCALARS([self WOTest_shortValue], other); // implicit cast
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
         return WO_COMPARE_SCALARS([self WOTest_longValue], other); // implicit cast
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other); // no cast
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
         return WO_COMPARE_SCALARS ([self WOTest_unsignedIntValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], other); // implicit cast
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1540,43 +1658,44 @@
 
 - (NSComparisonResult)WOTest_compareWithUnsignedInt:(unsigned int)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned char)[self WOTest_charValue], other); // explicit cast
     }
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned int)[self WOTest_intValue], other); // explicit cast
     }
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned short)[self WOTest_shortValue], other); // explicit cast
     }
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned long)[self WOTest_longValue], other); // explicit cast
     }
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedIntValue], other); // no cast
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], other); // implicit cast
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1588,31 +1707,32 @@
 
 - (NSComparisonResult)WOTest_compareWithUnsignedShort:(unsigned short)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
         return WO_COMPARE_SCALARS([self WOTest_charValue], other); // implicit cast
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
         return WO_COMPARE_SCALARS([self WOTest_intValue], other); // implicit cast
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
         return WO_COMPARE_SCALARS([self WOTest_shortValue], other); // implicit cast
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
         return WO_COMPARE_SCALARS([self WOTest_longValue], other); // implicit cast
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
         return WO_COMPARE_SCALARS ([self WOTest_unsignedIntValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // no cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], other); // implicit cast
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1624,43 +1744,44 @@
 
 - (NSComparisonResult)WOTest_compareWithUnsignedLong:(unsigned long)other
 {
-    if ([self WOTest_isChar]) // char (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // char (also BOOL)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned char)[self WOTest_charValue], other); // expicit cast
     }
-    else if ([self WOTest_isInt]) // int
+    else if (kind == WOTestIntType) // int
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned int)[self WOTest_intValue], other); // explicit cast
     }
-    else if ([self WOTest_isShort]) // short
+    else if (kind == WOTestShortType) // short
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned short)[self WOTest_shortValue], other); // explicit cast
     }
-    else if ([self WOTest_isLong]) // long
+    else if (kind == WOTestLongType) // long
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned long)[self WOTest_longValue], other); // explicit cast
     }
-    else if ([self WOTest_isLongLong]) // long long
+    else if (kind == WOTestLongLongType) // long long
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // unsigned char (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // unsigned char (also Boolean)
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedInt]) // unsigned int
+    else if (kind == WOTestUnsignedIntType) // unsigned int
         return WO_COMPARE_SCALARS([self WOTest_unsignedIntValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedShort]) // unsigned short
+    else if (kind == WOTestUnsignedShortType) // unsigned short
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong]) // unsigned long
+    else if (kind == WOTestUnsignedLongType) // unsigned long
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], other); // no cast
-    else if ([self WOTest_isUnsignedLongLong]) // unsigned long long
+    else if (kind == WOTestUnsignedLongLongType) // unsigned long long
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], other); // implicit cast
-    else if ([self WOTest_isFloat]) // float
+    else if (kind == WOTestFloatType) // float
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble]) // double
+    else if (kind == WOTestDoubleType) // double
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool]) // C99 _Bool
+    else if (kind == WOTestC99BoolType) // C99 _Bool
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1672,46 +1793,47 @@
 
 - (NSComparisonResult)WOTest_compareWithUnsignedLongLong:(unsigned long long)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned char)[self WOTest_charValue], other); // explicit cast
     }
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned int)[self WOTest_intValue], other); // explicit cast
     }
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned short)[self WOTest_shortValue], other); // explicit cast
     }
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned long)[self WOTest_longValue], other); // explicit cast
     }
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
     {
         [self WOTest_printSignCompareWarning:@"comparison between signed and unsigned, to avoid this warning use an explicit cast"];
         return WO_COMPARE_SCALARS((unsigned long long)[self WOTest_longLongValue], other); // explicit cast
     }
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedIntValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], other); // no cast
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1723,31 +1845,32 @@
 
 - (NSComparisonResult)WOTest_compareWithFloat:(float)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
         return WO_COMPARE_SCALARS([self WOTest_charValue], other); // implicit cast
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
         return WO_COMPARE_SCALARS([self WOTest_intValue], other); // implicit cast
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
         return WO_COMPARE_SCALARS([self WOTest_shortValue], other); // implicit cast
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
         return WO_COMPARE_SCALARS([self WOTest_longValue], other); // implicit cast
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
         return WO_COMPARE_SCALARS ([self WOTest_unsignedIntValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], other); // implicit cast
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // no cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1759,31 +1882,32 @@
 
 - (NSComparisonResult)WOTest_compareWithDouble:(double)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
         return WO_COMPARE_SCALARS([self WOTest_charValue], other); // implicit cast
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
         return WO_COMPARE_SCALARS([self WOTest_intValue], other); // implicit cast
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
         return WO_COMPARE_SCALARS([self WOTest_shortValue], other); // implicit cast
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
         return WO_COMPARE_SCALARS([self WOTest_longValue], other); // implicit cast
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
         return WO_COMPARE_SCALARS ([self WOTest_unsignedIntValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], other); // implicit cast
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // no cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // implicit cast
 
     // all other cases
@@ -1795,31 +1919,32 @@
 
 - (NSComparisonResult)WOTest_compareWithC99Bool:(_Bool)other
 {
-    if ([self WOTest_isChar]) // (also BOOL)
+    WOTestTypeKind kind = [self WOTest_typeDescriptor]->kind;
+    if (kind == WOTestCharType) // (also BOOL)
         return WO_COMPARE_SCALARS([self WOTest_charValue], other); // implicit cast
-    else if ([self WOTest_isInt])
+    else if (kind == WOTestIntType)
         return WO_COMPARE_SCALARS([self WOTest_intValue], other); // implicit cast
-    else if ([self WOTest_isShort])
+    else if (kind == WOTestShortType)
         return WO_COMPARE_SCALARS([self WOTest_shortValue], other); // implicit cast
-    else if ([self WOTest_isLong])
+    else if (kind == WOTestLongType)
         return WO_COMPARE_SCALARS([self WOTest_longValue], other); // implicit cast
-    else if ([self WOTest_isLongLong])
+    else if (kind == WOTestLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_longLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedChar]) // (also Boolean)
+    else if (kind == WOTestUnsignedCharType) // (also Boolean)
         return WO_COMPARE_SCALARS([self WOTest_unsignedCharValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedInt])
+    else if (kind == WOTestUnsignedIntType)
         return WO_COMPARE_SCALARS ([self WOTest_unsignedIntValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedShort])
+    else if (kind == WOTestUnsignedShortType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedShortValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLong])
+    else if (kind == WOTestUnsignedLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongValue], other); // implicit cast
-    else if ([self WOTest_isUnsignedLongLong])
+    else if (kind == WOTestUnsignedLongLongType)
         return WO_COMPARE_SCALARS([self WOTest_unsignedLongLongValue], other); // implicit cast
-    else if ([self WOTest_isFloat])
+    else if (kind == WOTestFloatType)
         return WO_COMPARE_SCALARS([self WOTest_floatValue], other); // implicit cast
-    else if ([self WOTest_isDouble])
+    else if (kind == WOTestDoubleType)
         return WO_COMPARE_SCALARS([self WOTest_doubleValue], other); // implicit cast
-    else if ([self WOTest_isC99Bool])
+    else if (kind == WOTestC99BoolType)
         return WO_COMPARE_SCALARS([self WOTest_C99BoolValue], other); // no cast
 
     // all other cases
@@ -23,9 +23,32 @@
 
 @implementation NSInvocationTests
 
+// not a test method: provides a signature with a qualified argument type ("r^v")
+- (void)takeBytes:(const void *)bytes
+{
+}
+
 - (void)testNSInvocationCategory
 {
     // WOTest_valueForArgumentAtIndex should throw for out-of-range index values
+    NSMethodSignature *signature = [self methodSignatureForSelector:@selector(takeBytes:)];
+    NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:signature];
+    [invocation setSelector:@selector(takeBytes:)];
+    WO_TEST_THROWS([invocation WOTest_valueForArgumentAtIndex:3]);
+
+    // type qualifiers such as "const" should not stop arguments from being read and compared
+    const void *bytes = "foo";
+    [invocation setArgument:&bytes atIndex:2];
+    NSValue *value;
+    WO_TEST_DOES_NOT_THROW(value = [invocation WOTest_valueForArgumentAtIndex:2]);
+    WO_TEST_EQ((const void *)[value pointerValue], bytes);
+    NSInvocation *other = [NSInvocation invocationWithMethodSignature:signature];
+    [other setSelector:@selector(takeBytes:)];
+    [other setArgument:&bytes atIndex:2];
+    WO_TEST_TRUE([invocation WOTest_isEqualToInvocation:other]);
+    const void *otherBytes = "bar";
+    [other setArgument:&otherBytes atIndex:2];
+    WO_TEST_FALSE([invocation WOTest_isEqualToInvocation:other]);
 }
 
 @end
@@ -678,6 +678,30 @@ typedef struct {
     // preliminaries
     NSValue *value = nil;
 
+    // test with int array
+    int ints[4] = { 1, 2, 3, 4 };
+    value = [NSValue valueWithBytes:&ints objCType:@encode(typeof(ints))];
+    WO_TEST_GTE([NSValue WOTest_sizeForType:[value WOTest_objCTypeString]], sizeof(ints));
+    WO_TEST_GTE([value WOTest_bufferSize], sizeof(ints));
+    WO_TEST_EQ([value WOTest_arrayCount], (unsigned)4);
+    WO_TEST_EQ([value WOTest_arrayType], [NSString stringWithUTF8String:@encode(int)]);
+
+    // test with char array
+    char chars[8] = "foobar";
+    value = [NSValue valueWithBytes:&chars objCType:@encode(typeof(chars))];
+    WO_TEST_TRUE([value WOTest_isCharArray]);
+    WO_TEST_EQ([value WOTest_bufferSize], sizeof(chars));
+
+    // descriptors are interned: equal encodings from different buffers yield the same descriptor
+    char encoding[16];
+    strncpy(encoding, @encode(typeof(ints)), sizeof(encoding));
+    WO_TEST_TRUE(WOTestDescriptorForType(encoding) == WOTestDescriptorForType(@encode(typeof(ints))));
+    WO_TEST_TRUE(WOTestDescriptorForType(encoding)->elementType == WOTestDescriptorForType(@encode(int)));
+
+    // the per-thread cache is keyed by address, but a buffer reused for another encoding still gets the right descriptor
+    strncpy(encoding, @encode(typeof(chars)), sizeof(encoding));
+    WO_TEST_TRUE(WOTestDescriptorForType(encoding) == WOTestDescriptorForType(@encode(typeof(chars))));
+    WO_TEST_TRUE(WOTestDescriptorForType(encoding)->elementType == WOTestDescriptorForType(@encode(char)));
 }
 
 - (void)testTypeStringMethods
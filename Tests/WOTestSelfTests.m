@@ -24,6 +24,10 @@
 #import <objc/objc-class.h>
 #import <objc/objc-runtime.h>
 #import <objc/Protocol.h>
+#import <float.h>
+
+// framework headers
+#import "WOLightweightRoot.h"
 
 // empty class that does not have the WOTest marker protocol at compile time
 @interface WOEmpty : NSObject {
@@ -124,6 +128,23 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
 
 @end
 
+// class whose only method overruns any short time budget; like WOEmpty it only conforms to WOTest once a test adds the
+// protocol, so it is never run by itself
+@interface WOOvertime : NSObject {
+
+}
+
+@end
+
+@implementation WOOvertime
+
+- (void)testSleepPastBudget
+{
+    [NSThread sleepForTimeInterval:0.5];
+}
+
+@end
+
 #pragma mark -
 #pragma mark Unit tests
 
@@ -191,7 +212,8 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
         @"-testShorthandMacros",
         @"-testExceptionTests",
         @"-testLowLevelExceptionTests",
-        @"-testRandomValueGeneratorMethods", nil];
+        @"-testRandomValueGeneratorMethods",
+        @"-testTimeouts", nil];
 
     NSSet *actualMethods =[NSSet setWithArray:
         [WO_TEST_SHARED_INSTANCE testableMethodsFrom:[self class]]];
@@ -203,6 +225,51 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
 
     WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE runTestsForClassName:nil]);
     WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE runTestsForClass:nil]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE runTestsForClassNames:nil]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE classNamesSortedByDuration:nil]);
+
+    // per-class time budgets override the default, and a budget of 0 removes the limit for that class
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE setTimeout:1.0 forClassName:nil]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE timeoutForClassName:nil]);
+    WO_TEST_EQ([WO_TEST_SHARED_INSTANCE timeoutForClassName:@"WOTestUnbudgeted"], [WO_TEST_SHARED_INSTANCE defaultTimeout]);
+    [WO_TEST_SHARED_INSTANCE setTimeout:5.0 forClassName:@"WOTestBudgeted"];
+    WO_TEST_EQ([WO_TEST_SHARED_INSTANCE timeoutForClassName:@"WOTestBudgeted"], 5.0);
+    [WO_TEST_SHARED_INSTANCE setTimeout:0.0 forClassName:@"WOTestBudgeted"];
+    WO_TEST_EQ([WO_TEST_SHARED_INSTANCE timeoutForClassName:@"WOTestBudgeted"], 0.0);
+
+    // identifiers key the timings file
+    WO_TEST_EQ([WO_TEST_SHARED_INSTANCE identifierForMethod:@"-testFoo" ofClassName:@"Bar"], @"Bar/-testFoo");
+
+    // classes with no recorded timings keep alphabetical order
+    NSArray *unknown = [NSArray arrayWithObjects:@"WOTestUntimedB", @"WOTestUntimedA", nil];
+    NSArray *sorted = [NSArray arrayWithObjects:@"WOTestUntimedA", @"WOTestUntimedB", nil];
+    WO_TEST_EQ([WO_TEST_SHARED_INSTANCE classNamesSortedByDuration:unknown], sorted);
+    WO_TEST_LESS_THAN([WO_TEST_SHARED_INSTANCE durationForClassName:@"WOTestUntimedA"], 0.0);
+
+    // shards are disjoint and together cover every method
+    NSArray *classNames = [NSArray arrayWithObject:NSStringFromClass([self class])];
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE methodsForShard:0 of:0 classNames:classNames balanced:NO]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE methodsForShard:2 of:2 classNames:classNames balanced:NO]);
+    NSArray *allMethods = [WO_TEST_SHARED_INSTANCE testableMethodsFrom:[self class]];
+    NSMutableSet *sharded = [NSMutableSet set];
+    unsigned shardedCount = 0;
+    for (unsigned i = 0; i < 3; i++)
+    {
+        NSDictionary *shard = [WO_TEST_SHARED_INSTANCE methodsForShard:i of:3 classNames:classNames balanced:NO];
+        for (NSArray *methods in [shard allValues])
+        {
+            [sharded addObjectsFromArray:methods];
+            shardedCount += [methods count];
+        }
+    }
+    WO_TEST_EQ(sharded, [NSSet setWithArray:allMethods]);
+    WO_TEST_EQ(shardedCount, (unsigned)[allMethods count]);
+
+    // shards worked out from names (as when listing a manifest) agree with those worked out from descriptors
+    NSDictionary *inventory = [NSDictionary dictionaryWithObject:allMethods forKey:NSStringFromClass([self class])];
+    for (unsigned i = 0; i < 3; i++)
+        WO_TEST_EQ([WO_TEST_SHARED_INSTANCE methodsForShard:i of:3 classNames:classNames inventory:inventory balanced:NO],
+                   [WO_TEST_SHARED_INSTANCE methodsForShard:i of:3 classNames:classNames balanced:NO]);
 }
 
 - (void)testTestableMethodsFrom
@@ -216,6 +283,35 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
     NSSet *actualMethods = [NSSet setWithArray:
         [WO_TEST_SHARED_INSTANCE testableMethodsFrom:[WOEmpty class]]];
     WO_TEST_EQ(expectedMethods, actualMethods);
+
+    // descriptors describe the same methods, and names parsed back into descriptors give the same names
+    NSData *descriptors = [WO_TEST_SHARED_INSTANCE testableMethodDescriptorsFrom:[WOEmpty class]];
+    NSArray *names = [WO_TEST_SHARED_INSTANCE methodNamesForDescriptors:descriptors];
+    WO_TEST_EQ(names, [WO_TEST_SHARED_INSTANCE testableMethodsFrom:[WOEmpty class]]);
+    WO_TEST_EQ([WO_TEST_SHARED_INSTANCE methodNamesForDescriptors:
+        [WO_TEST_SHARED_INSTANCE descriptorsForMethods:names ofClass:[WOEmpty class]]], names);
+    WO_TEST_EQ([WO_TEST_SHARED_INSTANCE identifierForDescriptor:*(const WOTestMethodDescriptor *)[descriptors bytes]],
+               @"WOEmpty/+testClassMethod");
+
+    // glob and regular expression patterns (matched without adding filters, which would affect other test classes running
+    // at the same time and which the command line may already have set)
+    WO_TEST_TRUE([WO_TEST_SHARED_INSTANCE method:@"+testClassMethod" ofClassName:@"WOEmpty" matchesPattern:@"WOEmpty/+test*"]);
+    WO_TEST_FALSE([WO_TEST_SHARED_INSTANCE method:@"-testInstanceMethod" ofClassName:@"WOEmpty"
+                                  matchesPattern:@"WOEmpty/+test*"]);
+    WO_TEST_TRUE([WO_TEST_SHARED_INSTANCE method:@"-testInstanceMethod" ofClassName:@"WOEmpty" matchesPattern:@"-test*"]);
+    WO_TEST_FALSE([WO_TEST_SHARED_INSTANCE method:@"-testInstanceMethod" ofClassName:@"WOEmpty" matchesPattern:@"Other/-test*"]);
+    WO_TEST_TRUE([WO_TEST_SHARED_INSTANCE method:@"-testInstanceMethod" ofClassName:@"WOEmpty"
+                                 matchesPattern:@"/^WOEmpty/-.+Method$/"]);
+    WO_TEST_FALSE([WO_TEST_SHARED_INSTANCE method:@"+testClassMethod" ofClassName:@"WOEmpty"
+                                  matchesPattern:@"/^WOEmpty/-.+Method$/"]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE method:@"-testInstanceMethod" ofClassName:@"WOEmpty" matchesPattern:@"/(/"]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE addMethodFilter:@"/(/" excluding:YES]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE addMethodFilter:nil excluding:NO]);
+
+    // filters select methods but never hide them from discovery
+    WO_TEST_EQ([NSSet setWithArray:[WO_TEST_SHARED_INSTANCE testableMethodsFrom:[WOEmpty class]]], expectedMethods);
+    for (NSString *method in [WO_TEST_SHARED_INSTANCE selectedMethodsFrom:[WOEmpty class]])
+        WO_TEST_TRUE([WO_TEST_SHARED_INSTANCE method:method passesFiltersForClassName:@"WOEmpty"]);
 }
 
 - (void)testPreAndPostflightMethods
@@ -274,6 +370,17 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
     WO_TEST_NOT_NIL([@"short" substringToIndex:10000]);
 }
 
+// helper for testEmptyTests: makes passing assertions on a secondary thread, then signals \p lock
+- (void)passOnSecondaryThread:(NSConditionLock *)lock
+{
+    NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    [lock lock];
+    for (unsigned i = 0; i < 100; i++)
+        WO_TEST_PASS;
+    [lock unlockWithCondition:1];
+    [pool drain];
+}
+
 - (void)testEmptyTests
 {
     // should pass
@@ -283,6 +390,28 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
     [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
     WO_TEST_FAIL;
     [WO_TEST_SHARED_INSTANCE setExpectFailures:NO];
+
+    // passes which aren't logged should still be counted (using this thread's counts, which other workers can't change)
+    BOOL logsPassedTests = [WO_TEST_SHARED_INSTANCE logsPassedTests];
+    unsigned passed = [WO_TEST_SHARED_INSTANCE resultsForCurrentThread].testsPassed;
+    [WO_TEST_SHARED_INSTANCE setLogsPassedTests:NO];
+    WO_TEST_PASS;
+    WO_TEST_EQUAL(@"foo", @"foo");
+    [WO_TEST_SHARED_INSTANCE setLogsPassedTests:logsPassedTests];
+    WO_TEST_EQ([WO_TEST_SHARED_INSTANCE resultsForCurrentThread].testsPassed, passed + 2);
+
+    // assertions made on other threads are included in the totals, and aren't affected by this thread's expectFailures setting
+    WOTestResults before = [WO_TEST_SHARED_INSTANCE results];
+    NSConditionLock *lock = [[[NSConditionLock alloc] initWithCondition:0] autorelease];
+    [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
+    [NSThread detachNewThreadSelector:@selector(passOnSecondaryThread:) toTarget:self withObject:lock];
+    [lock lockWhenCondition:1];
+    [lock unlock];
+    [WO_TEST_SHARED_INSTANCE setExpectFailures:NO];
+    WOTestResults after = [WO_TEST_SHARED_INSTANCE results];
+    WO_TEST_NOT_LESS_THAN(after.testsRun, before.testsRun + 100);
+    WO_TEST_NOT_LESS_THAN(after.testsPassed, before.testsPassed + 100);
+    WO_TEST_EQ(after.testsPassedUnexpected, before.testsPassedUnexpected);
 }
 
 - (void)testBooleanTests
@@ -1099,6 +1228,16 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
     WO_TEST_EQUAL(string5, string6);
     WO_TEST_EQUAL(string6, string5);
 
+    // truncation applies to the collapsed string
+    BOOL truncated = YES;
+    WO_TEST_EQ([string1 WOTest_stringByCollapsingWhitespaceTruncatedAt:5 didTruncate:&truncated], @"Fun F");
+    WO_TEST_TRUE(truncated);
+    WO_TEST_EQ([string1 WOTest_stringByCollapsingWhitespaceTruncatedAt:8 didTruncate:&truncated], string2);
+    WO_TEST_FALSE(truncated);
+    WO_TEST_EQ([string1 WOTest_stringByCollapsingWhitespaceTruncatedAt:0 didTruncate:&truncated], string2);
+    WO_TEST_FALSE(truncated);
+    WO_TEST_EQ([@"" WOTest_stringByCollapsingWhitespaceTruncatedAt:5 didTruncate:NULL], @"");
+
     // should fail
     [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
 
@@ -1607,11 +1746,29 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
 - (void)testFloatWithErrorMarginTests
 {
     // should pass
+    float expected[1000], actual[1000];
+    for (unsigned i = 0; i < 1000; i++)
+        expected[i] = actual[i] = (float)i / 7.0f;
+    actual[600] = nextafterf(expected[600], 1000.0f);  // one ulp out, in a block after the first
+    WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_ULPS(actual, expected, 1000, 1);
+    WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_ERROR(actual, expected, 1000, 0.001f);
+    WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_RELATIVE_ERROR(actual, expected, 1000, 0.001f);
+    WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_ERROR(NULL, NULL, 0, 0.0f);
+    float infinities[2] = { INFINITY, -INFINITY };
+    WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_TOLERANCE(infinities, infinities, 2, 1.0f, 1.0f, 1);
 
     // should fail
     [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
 
+    WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_ULPS(actual, expected, 1000, 0);
 
+    // infinities only match themselves, whatever the tolerance
+    float others[3] = { 1.0f, INFINITY, FLT_MAX };
+    WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_RELATIVE_ERROR(infinities, others, 1, 1e-6f);
+    WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_TOLERANCE(infinities + 1, others + 1, 1, 1.0f, 1.0f, 1);  // -inf against +inf
+    WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_ULPS(others + 2, infinities, 1, 1);   // the largest finite value is one ulp away
+    actual[900] = NAN;
+    WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_TOLERANCE(actual, expected, 1000, 1.0f, 1.0f, 10);
 
     [WO_TEST_SHARED_INSTANCE setExpectFailures:NO]; // restore to default
 }
@@ -1631,11 +1788,29 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
 - (void)testDoubleWithErrorMarginTests
 {
     // should pass
+    double expected[1000], actual[1000];
+    for (unsigned i = 0; i < 1000; i++)
+        expected[i] = actual[i] = (double)i / 7.0;
+    actual[600] = nextafter(expected[600], 1000.0);  // one ulp out, in a block after the first
+    WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_ULPS(actual, expected, 1000, 1);
+    WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_ERROR(actual, expected, 1000, 0.001);
+    WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_RELATIVE_ERROR(actual, expected, 1000, 0.001);
+    WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_ERROR(NULL, NULL, 0, 0.0);
+    double infinities[2] = { INFINITY, -INFINITY };
+    WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_TOLERANCE(infinities, infinities, 2, 1.0, 1.0, 1);
 
     // should fail
     [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
 
+    WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_ULPS(actual, expected, 1000, 0);
 
+    // infinities only match themselves, whatever the tolerance
+    double others[3] = { 1.0, INFINITY, DBL_MAX };
+    WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_RELATIVE_ERROR(infinities, others, 1, 1e-6);
+    WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_TOLERANCE(infinities + 1, others + 1, 1, 1.0, 1.0, 1);  // -inf against +inf
+    WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_ULPS(others + 2, infinities, 1, 1);   // the largest finite value is one ulp away
+    actual[900] = NAN;
+    WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_TOLERANCE(actual, expected, 1000, 1.0, 1.0, 10);
 
     [WO_TEST_SHARED_INSTANCE setExpectFailures:NO]; // restore to default
 }
@@ -1643,7 +1818,15 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
 - (void)testObjectTests
 {
     // should pass
+    WO_TEST_EQ(@"foo", @"foo");
+    WO_TEST_NE(@"foo", @"bar");
 
+    // identical objects are equal without sending isEqual:, which these objects don't implement or record as unexpected
+    WOLightweightRoot *root = [WOLightweightRoot newLightweightRoot];
+    WO_TEST_EQ(root, root);
+    id mock = [WOMock mockForObjectClass:[NSString class]];
+    WO_TEST_EQ(mock, mock);
+    WO_TEST_NE(root, mock);
 
     // should freak out if object does not conform to NSObject protocol
 
@@ -1652,7 +1835,8 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
     // should fail
     [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
 
-
+    WO_TEST_EQ(root, [WOLightweightRoot newLightweightRoot]);
+    WO_TEST_NE(root, root);
 
     [WO_TEST_SHARED_INSTANCE setExpectFailures:NO]; // restore to default
 }
@@ -1660,35 +1844,58 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
 - (void)testStringTests
 {
     // should pass
-
+    WO_TEST_STRINGS_EQUAL(@"foo", @"foo");
+    WO_TEST_STRING_HAS_PREFIX(@"foobar", @"foo");
+    WO_TEST_STRING_HAS_SUFFIX(@"foobar", @"bar");
+    WO_TEST_STRING_CONTAINS(@"foobar", @"oba");
+    WO_TEST_STRING_DOES_NOT_CONTAIN(@"foobar", @"baz");
 
     // should freak out if object does not conform to NSObject protocol
 
     // should throw an exception when passed an object that is not a subclass of NSString
 
     // specifically should throw an WO_TEST_CLASS_MISMATCH_EXCEPTION
+    WO_TEST_THROWS_EXCEPTION_NAMED([WO_TEST_SHARED_INSTANCE testString:(NSString *)[NSArray array] isEqualTo:@"foo" inFile:__FILE__ atLine:__LINE__], WO_TEST_CLASS_MISMATCH_EXCEPTION);
 
     // should handle nil string1
 
     // should handle nil string2
 
     // should handle nil string1 and nil string2
+    WO_TEST_STRINGS_EQUAL(nil, nil);
 
     // should handle empty string1
 
     // should handle empty string2
 
     // should handle empty string1 and empty string2
+    WO_TEST_STRINGS_EQUAL(@"", @"");
 
     // shorthand macros should work
-
+    WO_TEST_STRINGS_EQ(@"foo", @"foo");
+    WO_TEST_STRINGS_NE(@"foo", @"bar");
 
     // in the case of prefix, suffix and contains tests should die if passed nil "expected" parameter
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE testString:@"foo" hasPrefix:nil inFile:__FILE__ atLine:__LINE__]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE testString:@"foo" hasSuffix:nil inFile:__FILE__ atLine:__LINE__]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE testString:@"foo" contains:nil inFile:__FILE__ atLine:__LINE__]);
 
     // should fail
     [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
 
+    WO_TEST_STRINGS_EQUAL(nil, @"foo");
+    WO_TEST_STRINGS_EQUAL(@"foo", @"foobar");                   // difference at the end of the shorter string
+    WO_TEST_STRING_HAS_PREFIX(@"foobar", @"fob");
+    WO_TEST_STRING_HAS_SUFFIX(@"foobar", @"foo");
 
+    // large multi-line strings report the first difference and the lines around it
+    NSMutableString *document = [NSMutableString string];
+    for (unsigned i = 0; i < 10000; i++)
+        [document appendFormat:@"line %u\tof a generated document\n", i];
+    NSMutableString *edited = [[document mutableCopy] autorelease];
+    [edited replaceCharactersInRange:[edited rangeOfString:@"line 9000\t"] withString:@"line 9000 "];
+    WO_TEST_STRINGS_EQUAL(edited, document);
+    WO_TEST_STRING_HAS_PREFIX(@"foo", document);
 
     [WO_TEST_SHARED_INSTANCE setExpectFailures:NO]; // restore to default
 }
@@ -1696,23 +1903,65 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
 - (void)testArrayTests
 {
     // should pass
+    unsigned char bytes[1024], copy[1024];
+    for (unsigned i = 0; i < sizeof(bytes); i++)
+        bytes[i] = (unsigned char)i;
+    memcpy(copy, bytes, sizeof(bytes));
+    WO_TEST_BUFFERS_EQUAL(copy, bytes, sizeof(bytes));
+    WO_TEST_BUFFERS_EQUAL(NULL, NULL, 0);
+    WO_TEST_DATA_EQUAL([NSData dataWithBytes:copy length:sizeof(copy)], [NSData dataWithBytes:bytes length:sizeof(bytes)]);
+    WO_TEST_DATA_EQUAL([NSData data], [NSData data]);
+    WO_TEST_DATA_EQUAL(nil, nil);
+
+    // should throw
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE testBuffer:NULL isEqualTo:bytes length:sizeof(bytes) inFile:__FILE__ atLine:__LINE__]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE testData:(NSData *)@"foo" isEqualTo:[NSData data] inFile:__FILE__ atLine:__LINE__]);
 
     // should fail
     [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
 
-
+    copy[700] = 0;  // in a block after the first
+    WO_TEST_BUFFERS_EQUAL(copy, bytes, sizeof(bytes));
+    WO_TEST_DATA_EQUAL([NSData dataWithBytes:copy length:sizeof(copy)], [NSData dataWithBytes:bytes length:sizeof(bytes)]);
+    WO_TEST_DATA_EQUAL([NSData dataWithBytes:bytes length:10], [NSData dataWithBytes:bytes length:sizeof(bytes)]);
+    WO_TEST_DATA_EQUAL(nil, [NSData data]);
+
+    // large arrays report a diff rather than their full descriptions
+    NSMutableArray *numbers = [NSMutableArray array];
+    for (unsigned i = 0; i < 10000; i++)
+        [numbers addObject:[NSNumber numberWithUnsignedInt:i]];
+    NSMutableArray *edited = [[numbers mutableCopy] autorelease];
+    [edited removeObjectAtIndex:5000];
+    [edited insertObject:@"inserted" atIndex:100];
+    WO_TEST_ARRAYS_EQUAL(edited, numbers);
+    WO_TEST_ARRAYS_EQUAL([NSArray array], numbers);                         // beyond the edit distance limit
+    WO_TEST_ARRAYS_EQUAL([[numbers reverseObjectEnumerator] allObjects], numbers);
 
     [WO_TEST_SHARED_INSTANCE setExpectFailures:NO]; // restore to default
 }
 
 - (void)testDictionaryTests
 {
+    NSDictionary *dictionary = [NSDictionary dictionaryWithObjectsAndKeys:@"1", @"one", @"2", @"two", @"3", @"three", nil];
+
     // should pass
+    WO_TEST_DICTIONARIES_EQUAL(dictionary, [[dictionary mutableCopy] autorelease]);
+    WO_TEST_DICTIONARIES_EQUAL(nil, nil);
+    WO_TEST_DICTIONARIES_NOT_EQUAL(dictionary, [NSDictionary dictionary]);
+
+    // should throw
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE testDictionary:(NSDictionary *)@"foo" isEqualTo:dictionary inFile:__FILE__ atLine:__LINE__]);
+    WO_TEST_THROWS([WO_TEST_SHARED_INSTANCE testDictionary:dictionary isEqualTo:(NSDictionary *)[NSArray array] inFile:__FILE__ atLine:__LINE__]);
 
     // should fail
     [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
 
-
+    NSMutableDictionary *edited = [[dictionary mutableCopy] autorelease];
+    [edited removeObjectForKey:@"one"];         // missing
+    [edited setObject:@"22" forKey:@"two"];     // changed
+    [edited setObject:@"4" forKey:@"four"];     // unexpected
+    WO_TEST_DICTIONARIES_EQUAL(edited, dictionary);
+    WO_TEST_DICTIONARIES_EQUAL(nil, dictionary);
 
     [WO_TEST_SHARED_INSTANCE setExpectFailures:NO]; // restore to default
 }
@@ -1753,6 +2002,19 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
     WO_TEST_GTE(100, 100);
     WO_TEST_NLT(100, 100);
 
+    // operands of different widths (compared without boxing them in NSValue objects)
+    WO_TEST_EQ((char)100, 100LL);
+    WO_TEST_EQ((short)-1, -1L);
+    WO_TEST_EQ((unsigned short)65535, 65535U);
+    WO_TEST_GT(0xffffffffffffffffULL, (unsigned char)255);
+    WO_TEST_LT(-9223372036854775807LL, (short)0);
+    WO_TEST_GT(2.5f, 2.0);
+    WO_TEST_EQ(0.5f, 0.5);
+    WO_TEST_EQ(@"string", [NSString stringWithUTF8String:"string"]);
+    WO_TEST_NE(@"string", @"other");
+    WO_TEST_EQ((void *)self, (void *)self);
+    WO_TEST_NE((void *)self, NULL);
+
     // should fail
     [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
 
@@ -1779,6 +2041,12 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
     WO_TEST_GTE(100, 200);
     WO_TEST_NLT(100, 200);
 
+    WO_TEST_EQ((char)-1, 255LL);
+    WO_TEST_EQ((unsigned char)255, 0xffffffffffffffffULL);
+    WO_TEST_LT(2.5f, 2.0);
+    WO_TEST_EQ(@"string", @"other");
+    WO_TEST_NE((void *)self, (void *)self);
+
     [WO_TEST_SHARED_INSTANCE setExpectFailures:NO]; // restore to default
 }
 
@@ -2019,4 +2287,27 @@ NSMutableArray *WOEmptyInstanceMethodInvocations;
     [WO_TEST_SHARED_INSTANCE setExpectFailures:NO];
 }
 
+- (void)testTimeouts
+{
+    // when a timeout would terminate the process there is nothing to count
+    if ([WO_TEST_SHARED_INSTANCE exitsOnTimeout])
+        return;
+
+    BOOL added = [WOOvertime conformsToProtocol:@protocol(WOTest)] || class_addProtocol([WOOvertime class], @protocol(WOTest));
+    NSAssert(added, @"class_addProtocol failed");
+
+    // an overrun counts as one failed test of the hung method, on its own thread (this one; inverted here so that the suite
+    // still passes)
+    [WO_TEST_SHARED_INSTANCE setTimeout:0.1 forClassName:@"WOOvertime"];
+    WOTestResults before = [WO_TEST_SHARED_INSTANCE resultsForCurrentThread];
+    [WO_TEST_SHARED_INSTANCE setExpectFailures:YES];
+    [WO_TEST_SHARED_INSTANCE runTestsForClass:[WOOvertime class]];
+    [WO_TEST_SHARED_INSTANCE setExpectFailures:NO];
+    WOTestResults after = [WO_TEST_SHARED_INSTANCE resultsForCurrentThread];
+    [WO_TEST_SHARED_INSTANCE setTimeout:0.0 forClassName:@"WOOvertime"];
+    WO_TEST_EQ(after.testsRun, before.testsRun + 1);
+    WO_TEST_EQ(after.testsFailedExpected, before.testsFailedExpected + 1);
+    WO_TEST_EQ(after.testsFailed, before.testsFailed);
+}
+
 @end
@@ -158,12 +158,13 @@
 #elif defined(__i386__)
 
         // on i386 the marg_getRef macro and its helper, marg_adjustedOffset, should work fine
-        if (strcmp(type, @encode(id)) == 0)
+        WOTestTypeKind kind = WOTestDescriptorForType(type)->kind;
+        if (kind == WOTestObjectType)
         {
             id *ref = marg_getRef(args, offset, id);
             [forwardInvocation WOTest_setArgumentValue:[NSValue valueWithBytes:ref objCType:type] atIndex:i];
         }
-        else if (strcmp(type, @encode(SEL)) == 0)
+        else if (kind == WOTestSelectorType)
         {
             SEL *ref = marg_getRef(args, offset, SEL);
             [forwardInvocation WOTest_setArgumentValue:[NSValue valueWithBytes:ref objCType:type] atIndex:i];
@@ -171,7 +172,7 @@
         else
             [NSException raise:NSGenericException format:@"type %s not supported", type];
 
-        offset += [NSValue WOTest_sizeForType:[NSString stringWithUTF8String:type]];
+        offset += [NSValue WOTest_sizeForObjCType:type];
 
 #elif defined(__ppc64__)
         // there is no objc-msg-ppc.s so for now just omit support rather than make assumptions
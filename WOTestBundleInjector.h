@@ -25,4 +25,7 @@
 
 }
 
+/*! Returns the time taken to load each injected bundle, as an array of two-element arrays (the bundle path and an NSNumber holding the load time in seconds) in the order in which the bundles were loaded. Bundles which could not be loaded are not included. */
++ (NSArray *)bundleLoadTimes;
+
 @end
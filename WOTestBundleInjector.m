@@ -24,6 +24,9 @@
 // system headers
 #import <libkern/OSAtomic.h>        /* OSAtomicIncrement32Barrier() */
 
+// load times of the injected bundles (see bundleLoadTimes)
+static NSMutableArray *WOInjectedBundleLoadTimes = nil;
+
 @implementation WOTestBundleInjector
 
 + (void)load
@@ -34,6 +37,7 @@
         return;
 
     NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+    WOInjectedBundleLoadTimes = [[NSMutableArray alloc] init];
     char *inject = getenv("WOTestInjectBundle");
     if (inject)
     {
@@ -46,13 +50,18 @@
                 NSLog(@"WOTestBundleInjector: skipping bundle \"%@\" (absolute path required)", bundlePath);
                 continue;
             }
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
             NSBundle *bundle = [NSBundle bundleWithPath:path];
             if (!bundle)
                 NSLog(@"WOTestBundleInjector: unable to get bundle for path \"%@\"", bundlePath);
             else if ([bundle isLoaded])
                 NSLog(@"WOTestBundleInjector: skipping bundle \"%@\" (already loaded)", bundlePath);
             else if ([bundle load])
+            {
                 NSLog(@"WOTestBundleInjector: bundle \"%@\" loaded", bundlePath);
+                [WOInjectedBundleLoadTimes addObject:[NSArray arrayWithObjects:path,
+                    [NSNumber numberWithDouble:CFAbsoluteTimeGetCurrent() - start], nil]];
+            }
             else
                 // Note that you can't "load" application bundles this way, trying will wind up here
                 // not even with low-level functions like NSCreateObjectFileImageFromFile() and NSCreateObjectFileImageFromMemory()
@@ -65,4 +74,9 @@
     [pool drain];
 }
 
++ (NSArray *)bundleLoadTimes
+{
+    return WOInjectedBundleLoadTimes ? [NSArray arrayWithArray:WOInjectedBundleLoadTimes] : [NSArray array];
+}
+
 @end
@@ -20,25 +20,55 @@
 //
 
 #import <Foundation/Foundation.h>
+#import <pthread.h>
 
-@interface WOTest : NSObject {
+//! Posted on the thread running the tests just before each test method is run. The object is the WOTest shared instance and the userInfo dictionary contains the name of the class (WO_TEST_CLASS_NAME_KEY) and of the method (WO_TEST_METHOD_KEY).
+#define WO_TEST_WILL_RUN_METHOD_NOTIFICATION    @"WOTestWillRunMethodNotification"
 
-    NSDate      *startDate;
+//! Posted on the thread running the tests just after each test method has finished, whether or not it passed. The userInfo dictionary has the same keys as for WO_TEST_WILL_RUN_METHOD_NOTIFICATION.
+#define WO_TEST_DID_RUN_METHOD_NOTIFICATION     @"WOTestDidRunMethodNotification"
+
+#define WO_TEST_CLASS_NAME_KEY                  @"WOTestClassName"
+#define WO_TEST_METHOD_KEY                      @"WOTestMethod"
+
+//! Present in the userInfo of WO_TEST_DID_RUN_METHOD_NOTIFICATION only: an NSNumber containing the time taken by the method in seconds.
+#define WO_TEST_DURATION_KEY                    @"WOTestDuration"
 
+//! Present in the userInfo of WO_TEST_DID_RUN_METHOD_NOTIFICATION only: an NSNumber containing a BOOL which is YES if the method failed.
+#define WO_TEST_FAILED_KEY                      @"WOTestFailed"
+
+//! A snapshot of the results counters, used for passing results between processes and merging them back into the shared instance.
+typedef struct WOTestResults {
     unsigned    testsRun;
     unsigned    testsPassed;
     unsigned    testsFailed;
     unsigned    uncaughtExceptions;
-
-    //! test sense inversion: should only be used during WOTest self-testing
     unsigned    testsFailedExpected;
     unsigned    testsPassedUnexpected;
-    BOOL        expectFailures;
+    unsigned    lowLevelExceptionsExpected;
+    unsigned    lowLevelExceptionsUnexpected;
+} WOTestResults;
+
+//! A test method as discovered by copyTestableMethodDescriptorsFrom:count: and passed through selection to execution, usually in arrays wrapped in NSData objects; the "+name" and "-name" strings used elsewhere are only made from these for reporting.
+typedef struct WOTestMethodDescriptor {
+    Class       testClass;      //!< the class (never the metaclass) to which the method belongs
+    SEL         selector;
+    BOOL        isClassMethod;
+    unsigned    order;          //!< position of the method in its class's method lists (class methods first), or in the list of names it was made from
+} WOTestMethodDescriptor;
+
+@interface WOTest : NSObject {
+
+    NSDate      *startDate;
+
+    //! The results counters, test sense inversion (expectFailures) and the last reported path and line are kept per thread so
+    //! that assertions can be made from any thread without races or locking; the counter properties return the totals for all
+    //! threads. Contexts (WOTestThreadContext, private to WOTestClass.m) are only ever prepended to the list, never removed.
+    pthread_key_t               threadContextKey;
+    struct WOTestThreadContext  *volatile threadContexts;
 
     //! low-level exception handling inversion: should only be used during WOTest self-testing
     //! due to problems with the low-level exception handling this API may eventually be deprecated and removed
-    unsigned    lowLevelExceptionsExpected;
-    unsigned    lowLevelExceptionsUnexpected;
     BOOL        expectLowLevelExceptions;
 
     //! Internal use only: used for keeping track of whether low-level exception handlers have been installed or not
@@ -48,15 +78,59 @@
     //! 0 = mostly silent operation; 1 = verbose; 2 = very verbose
     unsigned    verbosity;
 
+    //! Whether passing assertions are logged ("Passed: ..."); defaults to YES. When NO, passes are only counted and their messages are never formatted. Failures, unexpected passes and expected failures are always logged.
+    BOOL        logsPassedTests;
+
     //! Optionally trim leading path components when printing path names to console.
     unsigned    trimInitialPathComponents;
 
-    //! Cache last reported path and last reported line number for use when printing warnings and errors which don't include file and line information
-    NSString    *lastReportedFile;
-    int         lastReportedLine;
-
     //! Defaults to YES.
     BOOL        warnsAboutSignComparisons;
+
+    //! Whether low-level exceptions (crashes) in test methods are caught using the jump buffer; defaults to YES. Child processes which are supervised by another process turn this off so that a crash terminates them cleanly.
+    BOOL        catchesLowLevelExceptions;
+
+    //! Durations (NSNumbers, in seconds) keyed by "Class/-method" identifiers, both loaded from a timings file and recorded during the run.
+    NSMutableDictionary *timings;
+
+    //! Identifiers ("Class/-method") of the methods which failed and passed during this run.
+    NSMutableSet        *failedMethods;
+    NSMutableSet        *passedMethods;
+
+    //! If YES, no further test methods are started once one has failed.
+    BOOL                stopsAfterFirstFailure;
+    BOOL                stopped;
+
+    //! Time budgets for test methods in seconds; 0 means no limit. Per-class budgets (NSNumbers keyed by class name) override the default.
+    NSTimeInterval      defaultTimeout;
+    NSMutableDictionary *classTimeouts;
+
+    //! If YES the process exits as soon as a test method exceeds its budget (used by supervised worker processes).
+    BOOL                exitsOnTimeout;
+
+    //! Internal use only: the test methods currently being watched, keyed by thread.
+    NSMutableDictionary *runningMethods;
+    BOOL                watchdogStarted;
+
+    //! Compiled method selection patterns (see addMethodFilter:excluding:).
+    NSMutableArray      *includedMethodFilters;
+    NSMutableArray      *excludedMethodFilters;
+
+    //! Testable class names (sorted NSArrays) keyed by image path, so that each loaded image is scanned at most once.
+    NSMutableDictionary *imageClassCache;
+
+    //! Total time spent finding the testable methods of classes (see copyTestableMethodDescriptorsFrom:count:).
+    NSTimeInterval      methodDiscoveryTime;
+
+    //! Number of worker threads used when running more than one test class; 0 or 1 means run serially on the calling thread.
+    unsigned    jobs;
+
+    //! Internal use only: bookkeeping for the worker threads started by runTestsForClassNames:
+    NSCondition *workerCondition;
+    unsigned    activeWorkers;
+    unsigned    workerFailures;
+    BOOL        runningInParallel;
+    NSDictionary *queuedDescriptors;
 }
 
 #pragma mark -
@@ -98,23 +172,152 @@
 /*! Returns YES if all tests pass, NO if any test fails. Raises an exception if className is nil. */
 - (BOOL)runTestsForClassName:(NSString *)className;
 
+/*! Runs the tests for each of the classes named in \p classNames. If the jobs property is greater than 1 the classes are spread over a pool of that many worker threads, each of which takes the next class off a shared queue whenever it finishes the previous one (the queue is ordered longest-first using classNamesSortedByDuration:); results from all threads are accumulated in the same counters reported by printTestResultsSummary. Note that the low-level exception handler is not installed while running in parallel because it relies on process-wide state. Returns YES if all tests pass, NO if any test fails. Raises an exception if classNames is nil. */
+- (BOOL)runTestsForClassNames:(NSArray *)classNames;
+
+/*! Like runTestsForClassNames: but if \p methods is not nil only the methods it lists (keyed by class name, in the format returned by testableMethodsFrom:) are run, and classes with no entry are skipped entirely. */
+- (BOOL)runTestsForClassNames:(NSArray *)classNames methods:(NSDictionary *)methods;
+
+/*! Like runTestsForClassNames:methods: but \p descriptors maps class names to NSData objects wrapping arrays of WOTestMethodDescriptor structs (as returned by testableMethodDescriptorsFrom:), which are run without any names being parsed. */
+- (BOOL)runTestsForClassNames:(NSArray *)classNames descriptors:(NSDictionary *)descriptors;
+
 /*! Returns YES if all tests pass, NO if any test fails. Raises an exception if aClass is nil. */
 - (BOOL)runTestsForClass:(Class)aClass;
 
-/*! Returns a list of class names (NSStrings) corresponding to all classes known to the runtime that conform to the WOTest protocol. */
+/*! Runs only the test methods of \p aClass named in \p methods (using the same "+name" and "-name" format returned by testableMethodsFrom:), in the order given. Passing nil runs all testable methods. Returns YES if all tests pass, NO if any test fails. Raises an exception if aClass is nil. */
+- (BOOL)runTestsForClass:(Class)aClass methods:(NSArray *)methods;
+
+/*! Like runTestsForClass:methods: but takes the methods as an NSData object wrapping an array of WOTestMethodDescriptor structs. */
+- (BOOL)runTestsForClass:(Class)aClass descriptors:(NSData *)descriptors;
+
+/*! Returns a list of class names (NSStrings) corresponding to all classes known to the runtime that conform to the WOTest protocol. System images (those under /System and /usr/lib) are not scanned as they can't contain tests. */
 - (NSArray *)testableClasses;
 
-/*! Like the allTestableClasses method, returns a list of class names (NSStrings) corresponding to all classes known to the runtime that conform to the WOTest protocol, with the additional limitation that only classes belonging to the specified bundle are included. */
+/*! Like the testableClasses method, returns a list of class names (NSStrings) corresponding to all classes known to the runtime that conform to the WOTest protocol, with the additional limitation that only classes belonging to the specified bundle are included. Only the bundle's executable is scanned. Returns an empty array if the bundle is not loaded. */
 - (NSArray *)testableClassesFrom:(NSBundle *)aBundle;
 
-/*! Given a class that conforms to the WOTest protocol, returns a list of method names (NSStrings) in that class that correspond to testable methods (in other words, method names that begin with the string "test"). */
+/*! Returns the names of the classes defined in the loaded image at \p imagePath (as reported by the runtime) which conform to the WOTest protocol, sorted by name. If the image registered its test classes with WO_TEST_REGISTER only those classes are examined; otherwise every class in the image is. The result is cached, so each image is only ever scanned once. */
+- (NSArray *)testableClassesInImage:(NSString *)imagePath;
+
+/*! Returns the class names recorded with WO_TEST_REGISTER in the loaded image at \p imagePath, or nil if the image has no registration section (or is not loaded). */
+- (NSArray *)registeredClassesInImage:(NSString *)imagePath;
+
+/*! Given a class that conforms to the WOTest protocol, returns a list of method names (NSStrings) in that class that correspond to testable methods (in other words, method names that begin with the string "test"). Filters added with addMethodFilter:excluding: are not applied; see selectedMethodsFrom:. */
 - (NSArray *)testableMethodsFrom:(Class)aClass;
 
+/*! Like testableMethodsFrom: but returns only the methods which pass the filters added with addMethodFilter:excluding:. */
+- (NSArray *)selectedMethodsFrom:(Class)aClass;
+
+/*! Like testableMethodsFrom: but returns an NSData object wrapping an array of WOTestMethodDescriptor structs. */
+- (NSData *)testableMethodDescriptorsFrom:(Class)aClass;
+
+/*! Like selectedMethodsFrom: but returns an NSData object wrapping an array of WOTestMethodDescriptor structs. */
+- (NSData *)selectedMethodDescriptorsFrom:(Class)aClass;
+
+/*! Like testableMethodsFrom: but returns a malloc'ed array of descriptors (which the caller must free) instead of strings, storing the number of descriptors in \p count. */
+- (WOTestMethodDescriptor *)copyTestableMethodDescriptorsFrom:(Class)aClass count:(unsigned *)count;
+
+/*! Returns a malloc'ed array of descriptors (which the caller must free) for \p methods, given in the "+name" and "-name" format, of \p aClass, in the order given; invalid names are reported and skipped. Stores the number of descriptors in \p count. */
+- (WOTestMethodDescriptor *)copyDescriptorsForMethods:(NSArray *)methods ofClass:(Class)aClass count:(unsigned *)count;
+
+/*! Like copyDescriptorsForMethods:ofClass:count: but returns an NSData object wrapping the array of descriptors. */
+- (NSData *)descriptorsForMethods:(NSArray *)methods ofClass:(Class)aClass;
+
+/*! Returns the "+name" and "-name" strings of the methods in \p descriptors, an NSData object wrapping an array of WOTestMethodDescriptor structs. */
+- (NSArray *)methodNamesForDescriptors:(NSData *)descriptors;
+
+/*! Returns the "+name" or "-name" string used to report the method described by \p descriptor. */
+- (NSString *)methodNameForDescriptor:(WOTestMethodDescriptor)descriptor;
+
+/*! Returns the "Class/-method" identifier (see identifierForMethod:ofClassName:) of the method described by \p descriptor. */
+- (NSString *)identifierForDescriptor:(WOTestMethodDescriptor)descriptor;
+
+/*! Restricts the methods returned by selectedMethodsFrom:. The filters only affect which methods are selected; testableMethodsFrom: and the runTestsForClass: family ignore them, so callers which want a filtered run pass the selected methods explicitly (as WOTestRunner does). Patterns are matched against method identifiers of the form "Class/-method" (see identifierForMethod:ofClassName:); a pattern of the form "/regex/" is a POSIX extended regular expression, anything else is a shell-style glob, and a glob without a "/" is matched against the method part only (so "-testAccept*" matches in any class). If any including filters have been added, only methods matching at least one of them are testable; methods matching an excluding filter never are. Patterns are compiled once, here; raises an NSInvalidArgumentException if \p pattern is not a valid regular expression. */
+- (void)addMethodFilter:(NSString *)pattern excluding:(BOOL)exclude;
+
+/*! Returns YES if \p method of the class named \p className passes the filters added with addMethodFilter:excluding:; used to apply the filters to methods which were not obtained from selectedMethodsFrom: (such as those listed in a manifest). */
+- (BOOL)method:(NSString *)method passesFiltersForClassName:(NSString *)className;
+
+/*! Returns YES if \p method of the class named \p className matches \p pattern, given in the form accepted by addMethodFilter:excluding:, without adding it as a filter. Raises an NSInvalidArgumentException if \p pattern is not a valid regular expression. */
+- (BOOL)method:(NSString *)method ofClassName:(NSString *)className matchesPattern:(NSString *)pattern;
+
+/*! Removes the filter previously added by passing the same arguments to addMethodFilter:excluding:. */
+- (void)removeMethodFilter:(NSString *)pattern excluding:(BOOL)exclude;
+
 - (void)printTestResultsSummary;
 
 //! Returns YES if there were no failures.
 - (BOOL)testsWereSuccessful;
 
+//! Returns a snapshot of the current values of the results counters.
+- (WOTestResults)results;
+
+//! Returns the results counters for assertions made on the calling thread only; unlike results, these can't be changed by other threads in the meantime.
+- (WOTestResults)resultsForCurrentThread;
+
+//! Adds \p results to the results counters; used to merge in results gathered by another process.
+- (void)addResults:(WOTestResults)results;
+
+/*! \endgroup */
+
+#pragma mark -
+#pragma mark Per-method results
+
+/*! \name Per-method results
+    \startgroup */
+
+/*! Records whether the method identified by \p method and \p className passed or failed. Called automatically for every method run by this process; exposed so that results from other processes can be merged in. If stopsAfterFirstFailure is set, recording a failure sets the stopped property. */
+- (void)recordResult:(BOOL)passed forMethod:(NSString *)method ofClassName:(NSString *)className;
+
+/*! Returns the identifiers (as returned by identifierForMethod:ofClassName:) of the methods which have failed so far. */
+- (NSSet *)failedMethods;
+
+/*! Returns the identifiers of the methods which have passed so far. */
+- (NSSet *)passedMethods;
+
+/*! \endgroup */
+
+#pragma mark -
+#pragma mark Timing methods
+
+/*! \name Timing methods
+    \startgroup */
+
+/*! Sets the time budget for each test method of the class named \p className, overriding defaultTimeout. Pass 0 to remove the limit for that class. Methods which exceed their budget are reported by a watchdog thread (naming the method and its last known location) and each counts as one failed test of the hung method; the watchdog cannot interrupt a hung method, but if exitsOnTimeout is set it terminates the process. */
+- (void)setTimeout:(NSTimeInterval)seconds forClassName:(NSString *)className;
+
+/*! Returns the time budget for the methods of the class named \p className, or 0 if there is no limit. */
+- (NSTimeInterval)timeoutForClassName:(NSString *)className;
+
+/*! Returns the identifier used to key per-method timings, of the form "Class/-method". */
+- (NSString *)identifierForMethod:(NSString *)method ofClassName:(NSString *)className;
+
+/*! Records \p seconds as the most recent duration of \p method. Called automatically for every method run by this process; exposed so that durations measured in other processes can be merged in. */
+- (void)recordDuration:(NSTimeInterval)seconds forMethod:(NSString *)method ofClassName:(NSString *)className;
+
+/*! Returns the total known duration of the test methods in the named class, or a negative value if no timings are known for it. */
+- (NSTimeInterval)durationForClassName:(NSString *)className;
+
+/*! Returns \p classNames reordered so that the classes known to take longest come first. Classes without any recorded timings are assumed to be new (and potentially slow) and are placed at the front; ties are broken alphabetically. */
+- (NSArray *)classNamesSortedByDuration:(NSArray *)classNames;
+
+/*! Splits the testable methods of the classes named in \p classNames into \p count shards and returns the methods belonging to shard \p index, as a dictionary mapping class names to arrays of methods (classes with no methods in the shard are omitted). By default each method is assigned according to a stable hash of its identifier, so the split only changes when methods are added or removed. If \p balanced is YES, methods with recorded timings are instead distributed greedily (longest first, to the least-loaded shard) and only methods without timings fall back to the hash; for the shards to be disjoint every machine must then use the same timings file. Raises an exception if \p count is 0 or \p index is not less than \p count. */
+- (NSDictionary *)methodsForShard:(unsigned)index of:(unsigned)count classNames:(NSArray *)classNames balanced:(BOOL)balanced;
+
+/*! Like methodsForShard:of:classNames:balanced: but works with descriptors: \p descriptors maps class names to NSData objects wrapping arrays of WOTestMethodDescriptor structs (pass nil to use all testable methods) and the result is in the same form. Identifiers are only made for the methods when \p balanced is YES. */
+- (NSDictionary *)descriptorsForShard:(unsigned)index of:(unsigned)count classNames:(NSArray *)classNames
+                          descriptors:(NSDictionary *)descriptors balanced:(BOOL)balanced;
+
+/*! Like methodsForShard:of:classNames:balanced: but takes the methods of each class from \p inventory (a dictionary mapping class names to arrays of methods, such as one read from a test manifest) instead of asking the runtime, so the classes need not be loaded. */
+- (NSDictionary *)methodsForShard:(unsigned)index of:(unsigned)count classNames:(NSArray *)classNames
+                        inventory:(NSDictionary *)inventory balanced:(BOOL)balanced;
+
+/*! Merges the timings stored in the property list at \p path into the receiver. Returns NO if the file does not exist or could not be read. */
+- (BOOL)loadTimingsFromFile:(NSString *)path;
+
+/*! Writes all known timings (those previously loaded plus those recorded during this run) to a property list at \p path. Returns YES on success. */
+- (BOOL)writeTimingsToFile:(NSString *)path;
+
 /*! \endgroup */
 
 #pragma mark -
@@ -128,7 +331,8 @@
 //! \name Logging methods
 //! \startgroup
 
-//! Keep track of last known file and line number
+//! Keep track of last known file and line number (for the calling thread)
+//! \p path is not copied, so it must outlive the test run (in practice it is always a __FILE__ literal)
 - (void)cacheFile:(char *)path line:(int)line;
 
 - (void)writeLastKnownLocation;
@@ -277,6 +481,48 @@
 
 /*! \endgroup */
 
+#pragma mark -
+#pragma mark long long test methods
+
+/*! \name long long test methods
+    \startgroup */
+
+/*! The generic comparison macros (WO_TEST_EQUAL and friends) use these for pairs of signed integers of any width, and the unsigned long long methods for pairs of unsigned integers, without boxing the operands in NSValue objects. */
+
+- (void)testLongLong:(long long)actual isEqualTo:(long long)expected inFile:(char *)path atLine:(int)line;
+
+- (void)testLongLong:(long long)actual isNotEqualTo:(long long)expected inFile:(char *)path atLine:(int)line;
+
+- (void)testLongLong:(long long)actual greaterThan:(long long)expected inFile:(char *)path atLine:(int)line;
+
+- (void)testLongLong:(long long)actual notGreaterThan:(long long)expected inFile:(char *)path atLine:(int)line;
+
+- (void)testLongLong:(long long)actual lessThan:(long long)expected inFile:(char *)path atLine:(int)line;
+
+- (void)testLongLong:(long long)actual notLessThan:(long long)expected inFile:(char *)path atLine:(int)line;
+
+/*! \endgroup */
+
+#pragma mark -
+#pragma mark unsigned long long test methods
+
+/*! \name unsigned long long test methods
+    \startgroup */
+
+- (void)testUnsignedLongLong:(unsigned long long)actual isEqualTo:(unsigned long long)expected inFile:(char *)path atLine:(int)line;
+
+- (void)testUnsignedLongLong:(unsigned long long)actual isNotEqualTo:(unsigned long long)expected inFile:(char *)path atLine:(int)line;
+
+- (void)testUnsignedLongLong:(unsigned long long)actual greaterThan:(unsigned long long)expected inFile:(char *)path atLine:(int)line;
+
+- (void)testUnsignedLongLong:(unsigned long long)actual notGreaterThan:(unsigned long long)expected inFile:(char *)path atLine:(int)line;
+
+- (void)testUnsignedLongLong:(unsigned long long)actual lessThan:(unsigned long long)expected inFile:(char *)path atLine:(int)line;
+
+- (void)testUnsignedLongLong:(unsigned long long)actual notLessThan:(unsigned long long)expected inFile:(char *)path atLine:(int)line;
+
+/*! \endgroup */
+
 #pragma mark -
 #pragma mark float test methods without error margins
 
@@ -401,6 +647,24 @@
 
 /*! \endgroup */
 
+#pragma mark -
+#pragma mark float and double array test methods
+
+/*! \name float and double array test methods
+    \startgroup */
+
+/*! Compares \p count floats at \p actual with those at \p expected. An element passes if it is equal to the expected one, or if it is within any of the tolerances: an absolute error of \p absoluteError, an error of \p relativeError times the larger of the two magnitudes, or a distance of \p ulps units in the last place. Pass 0 for tolerances which aren't wanted. NaNs only match NaNs. A single result is recorded, reporting the number of elements outside the tolerances and the largest error and its index. */
+- (void)testFloats:(const float *)actual areEqualTo:(const float *)expected count:(size_t)count
+     absoluteError:(float)absoluteError relativeError:(float)relativeError ulps:(unsigned)ulps
+            inFile:(char *)path atLine:(int)line;
+
+/*! The double counterpart of testFloats:areEqualTo:count:absoluteError:relativeError:ulps:inFile:atLine:. */
+- (void)testDoubles:(const double *)actual areEqualTo:(const double *)expected count:(size_t)count
+      absoluteError:(double)absoluteError relativeError:(double)relativeError ulps:(unsigned)ulps
+             inFile:(char *)path atLine:(int)line;
+
+/*! \endgroup */
+
 #pragma mark -
 #pragma mark Object test methods
 
@@ -461,6 +725,20 @@
 
 /*! \endgroup */
 
+#pragma mark -
+#pragma mark Buffer and NSData test methods
+
+/*! \name Buffer and NSData test methods
+    \startgroup */
+
+/*! Compares \p length bytes at \p actual with those at \p expected. On failure the offset of the first differing byte is reported along with a hex dump of the bytes around it. */
+- (void)testBuffer:(const void *)actual isEqualTo:(const void *)expected length:(size_t)length inFile:(char *)path atLine:(int)line;
+
+/*! Compares the contents of two NSData objects, reporting the first differing offset (or the shorter length, if one is a prefix of the other) and a hex dump around it on failure. */
+- (void)testData:(NSData *)actual isEqualTo:(NSData *)expected inFile:(char *)path atLine:(int)line;
+
+/*! \endgroup */
+
 #pragma mark -
 #pragma mark Exception test methods
 
@@ -540,6 +818,7 @@
 @property(readonly) unsigned        testsFailedExpected;
 @property(readonly) unsigned        testsPassedUnexpected;
 
+//! Test sense inversion: should only be used during WOTest self-testing. Applies to assertions made on the calling thread only.
 @property BOOL                      expectFailures;
 
 @property(readonly) unsigned        lowLevelExceptionsExpected;
@@ -548,10 +827,19 @@
 @property BOOL                      expectLowLevelExceptions;
 
 @property unsigned                  verbosity;
+@property BOOL                      logsPassedTests;
 @property unsigned                  trimInitialPathComponents;
+//! The location of the last assertion or report made on the calling thread, for use when printing warnings and errors which don't include file and line information.
 @property(readonly, copy) NSString  *lastReportedFile;
 @property(readonly) int             lastReportedLine;
 @property BOOL                      warnsAboutSignComparisons;
+@property BOOL                      catchesLowLevelExceptions;
+@property BOOL                      stopsAfterFirstFailure;
+@property(readonly) BOOL            stopped;
+@property NSTimeInterval            defaultTimeout;
+@property BOOL                      exitsOnTimeout;
+@property unsigned                  jobs;
+@property(readonly) NSTimeInterval  methodDiscoveryTime;
 
 //! \endgroup
 
@@ -29,6 +29,12 @@
 #import <unistd.h>                  /* write(), _exit() */
 #import <mach/mach.h>
 #import <pthread.h>
+#import <libkern/OSAtomic.h>        /* OSAtomicCompareAndSwapPtrBarrier(), OSAtomicIncrement32Barrier() */
+#import <float.h>                   /* FLT_MAX, DBL_MAX */
+#import <fnmatch.h>
+#import <mach-o/dyld.h>
+#import <mach-o/getsect.h>
+#import <regex.h>
 
 // framework headers
 #import "WOTest.h"
@@ -44,7 +50,8 @@
 #define WO_TRUNCATE_INDEX           64
 
 // return truncated description of \p object, expects a BOOL variable of the format objectTruncated to be defined within the same scope
-#define WO_DESC(object)             [self description:object truncatedAt:WO_TRUNCATE_INDEX didTruncate:&object ## Truncated]
+// along with a BOOL "reported" (see reportsResult:); results which won't be reported get nil rather than a description
+#define WO_DESC(object)             (reported ? [self description:object truncatedAt:WO_TRUNCATE_INDEX didTruncate:&object ## Truncated] : nil)
 
 // return untruncated description of object
 #define WO_LONG_DESC(object)        [self description:object truncatedAt:0 didTruncate:NULL]
@@ -63,6 +70,10 @@
 #define WO_EXPECTED_DICTIONARY_EXCEPTION_REASON(object)                     \
 [NSString stringWithFormat:@"Expected NSDictionary object but got object of class \"%@\"", NSStringFromClass([object class])]
 
+// convenience macro to throw exception when NSData type check fails
+#define WO_EXPECTED_DATA_EXCEPTION_REASON(object)                           \
+[NSString stringWithFormat:@"Expected NSData object but got object of class \"%@\"", NSStringFromClass([object class])]
+
 #define WO_NIL_PARAMETER_EXCEPTION_REASON @"A test which does not accept nil parameters was passed a nil parameter"
 
 // Return a random offset between 0 and WO_RANDOMIZATION_RANGE inclusive.
@@ -71,6 +82,95 @@
 // Return +1 or -1 randomly.
 #define WO_RANDOM_SIGN              ((BOOL)(random() % 2) ? 1 : -1)
 
+// the calling thread's context (see WOTestThreadContext), created on first use
+#define WO_THREAD_CONTEXT           WOThreadContextGet(threadContextKey, &threadContexts)
+
+// increment one of the results counters; each thread only ever touches its own counters, so no locking is needed
+#define WO_INCREMENT(counter)       do { WO_THREAD_CONTEXT->results.counter++; } while (0)
+
+// increment one of the results counters of another thread's context (only the watchdog does this; see runWatchdog:)
+#define WO_INCREMENT_IN(context, counter)                                                                   \
+    OSAtomicIncrement32Barrier((volatile int32_t *)&(context)->results.counter)
+
+//! Thread dictionary key used to flag the test method running on the current thread as having failed.
+#define WO_METHOD_FAILED_KEY        @"WOTestMethodFailed"
+
+//! How often the watchdog thread checks for test methods which have exceeded their time budget.
+#define WO_WATCHDOG_INTERVAL        0.1
+
+//! Increments one of the failure counters and flags the current method as failed.
+#define WO_FAILURE(counter)         do {                                                                    \
+    WO_INCREMENT(counter);                                                                                  \
+    [[[NSThread currentThread] threadDictionary] setObject:[NSNumber numberWithBool:YES]                    \
+                                                    forKey:WO_METHOD_FAILED_KEY];                           \
+} while (0)
+
+#pragma mark -
+#pragma mark Types
+
+//! Indices into the statistics gathered while scanning images for testable classes.
+enum {
+    WOScanTotal,            // the total number of classes
+    WOScanConforming,       // classes conforming to WOTest
+    WOScanNonconforming,    // unconforming classes
+    WOScanExcluded,         // excluded classes
+    WOScanExceptions,       // classes provoking exceptions
+    WOScanCachedImages,     // images whose testable classes were already known (and so were not scanned again)
+    WOScanCachedClasses,    // testable classes taken from those images
+    WOScanCountMax
+};
+
+//! A compiled method selection pattern; stored (by value) in NSData objects, each paired with the original pattern.
+typedef struct WOMethodFilter {
+    BOOL        isRegex;
+    regex_t     regex;          // used if isRegex is YES
+    char        glob[1024];     // used otherwise
+} WOMethodFilter;
+
+//! Results counters and reporting context for one thread. Allocated the first time the thread makes an assertion and never
+//! freed, so that the thread's counts still contribute to the totals after it has exited.
+typedef struct WOTestThreadContext {
+    WOTestResults               results;
+    BOOL                        expectFailures;
+    char                        *lastReportedPath;  // as passed in (usually a __FILE__ literal); only trimmed when reported
+    int                         lastReportedLine;
+    struct WOTestThreadContext  *next;
+} WOTestThreadContext;
+
+#pragma mark -
+#pragma mark Thread contexts
+
+static WOTestThreadContext *WOThreadContextCreate(pthread_key_t key, WOTestThreadContext *volatile *list)
+{
+    WOTestThreadContext *context = calloc(1, sizeof(WOTestThreadContext));
+    NSCAssert(context != NULL, @"calloc() failed");
+
+    // readers walk the list without locking, so it is only ever prepended to
+    do
+        context->next = *list;
+    while (!OSAtomicCompareAndSwapPtrBarrier(context->next, context, (void * volatile *)list));
+    pthread_setspecific(key, context);
+    return context;
+}
+
+static inline WOTestThreadContext *WOThreadContextGet(pthread_key_t key, WOTestThreadContext *volatile *list)
+{
+    WOTestThreadContext *context = pthread_getspecific(key);
+    return context ? context : WOThreadContextCreate(key, list);
+}
+
+static void WOAddResults(WOTestResults *total, const WOTestResults *results)
+{
+    total->testsRun                     += results->testsRun;
+    total->testsPassed                  += results->testsPassed;
+    total->testsFailed                  += results->testsFailed;
+    total->uncaughtExceptions           += results->uncaughtExceptions;
+    total->testsFailedExpected          += results->testsFailedExpected;
+    total->testsPassedUnexpected        += results->testsPassedUnexpected;
+    total->lowLevelExceptionsExpected   += results->lowLevelExceptionsExpected;
+    total->lowLevelExceptionsUnexpected += results->lowLevelExceptionsUnexpected;
+}
+
 #pragma mark -
 #pragma mark Class variables
 
@@ -115,6 +215,7 @@ OSStatus WOLowLevelExceptionHandler(ExceptionInformation *theException)
 {
     if (!WOTestCanJump)         // unexpected exception
     {
+        _WOLogPanicFlush();     // the writer thread may never get to run again
         fprintf(stderr, "error: WOTest internal error (unexpected exception in WOLowLevelExceptionHandler)\n");
         fprintf(stderr, "Exception type: %lu\n", (unsigned long)(theException->theKind));
         fflush(NULL);
@@ -153,17 +254,130 @@ OSStatus WOLowLevelExceptionHandler(ExceptionInformation *theException)
     return noErr;
 }
 
+#pragma mark -
+#pragma mark Notification userInfo
+
+//! The userInfo dictionary of WO_TEST_WILL_RUN_METHOD_NOTIFICATION and WO_TEST_DID_RUN_METHOD_NOTIFICATION. Holds the method's
+//! descriptor and only formats the class and method names if an observer asks for them.
+@interface WOTestMethodInfo : NSDictionary {
+
+    WOTestMethodDescriptor  descriptor;
+    NSString                *className;
+    NSString                *method;
+
+    //! nil in WO_TEST_WILL_RUN_METHOD_NOTIFICATION.
+    NSNumber                *duration;
+    NSNumber                *failed;
+}
+
+- (id)initWithDescriptor:(WOTestMethodDescriptor)aDescriptor duration:(NSNumber *)aDuration failed:(NSNumber *)aFailed;
+
+@end
+
+@implementation WOTestMethodInfo
+
+- (id)initWithDescriptor:(WOTestMethodDescriptor)aDescriptor duration:(NSNumber *)aDuration failed:(NSNumber *)aFailed
+{
+    if ((self = [super init]))
+    {
+        descriptor  = aDescriptor;
+        duration    = aDuration;
+        failed      = aFailed;
+    }
+    return self;
+}
+
+- (NSUInteger)count
+{
+    return duration ? 4 : 2;
+}
+
+- (id)objectForKey:(id)aKey
+{
+    if ([aKey isEqual:WO_TEST_CLASS_NAME_KEY])
+    {
+        if (!className)
+            className = NSStringFromClass(descriptor.testClass);
+        return className;
+    }
+    else if ([aKey isEqual:WO_TEST_METHOD_KEY])
+    {
+        if (!method)
+            method = [NSString stringWithFormat:@"%c%s", descriptor.isClassMethod ? '+' : '-', sel_getName(descriptor.selector)];
+        return method;
+    }
+    else if ([aKey isEqual:WO_TEST_DURATION_KEY])
+        return duration;
+    else if ([aKey isEqual:WO_TEST_FAILED_KEY])
+        return failed;
+    return nil;
+}
+
+- (NSEnumerator *)keyEnumerator
+{
+    NSArray *keys = duration ?
+        [NSArray arrayWithObjects:WO_TEST_CLASS_NAME_KEY, WO_TEST_METHOD_KEY, WO_TEST_DURATION_KEY, WO_TEST_FAILED_KEY, nil] :
+        [NSArray arrayWithObjects:WO_TEST_CLASS_NAME_KEY, WO_TEST_METHOD_KEY, nil];
+    return [keys objectEnumerator];
+}
+
+@end
+
 @interface WOTest ()
 
 - (void)installLowLevelExceptionHandler;
 - (void)removeLowLevelExceptionHandler;
 
+/*! Registers the method about to run on the current thread with the watchdog (starting it if necessary); \p timeout is its time budget, which must be positive. */
+- (void)beginWatchingMethod:(WOTestMethodDescriptor)descriptor timeout:(NSTimeInterval)timeout;
+
+/*! Unregisters the method running on the current thread; returns YES if it exceeded its budget. */
+- (BOOL)endWatchingMethod;
+
+/*! Body of the watchdog thread. */
+- (void)runWatchdog:(id)sender;
+
+/*! Like writeLastKnownLocation, but for the thread owning \p context; used by the watchdog to report where a hung method got to. */
+- (void)writeLastKnownLocationInContext:(WOTestThreadContext *)context;
+
+/*! Does the work for testableClassesInImage:, adding to the scanning statistics in \p counts (indexed by the WOScanCount constants). */
+- (NSArray *)testableClassesInImage:(NSString *)imagePath counts:(unsigned *)counts;
+
+/*! Returns the name under which the runtime knows the image containing the executable of \p aBundle, or nil if it is not loaded. */
+- (NSString *)imageNameForBundle:(NSBundle *)aBundle;
+
+/*! Returns YES if the method identifier \p identifier (a UTF-8 C string) passes the filters added with addMethodFilter:excluding:. */
+- (BOOL)methodIdentifierPassesFilters:(const char *)identifier;
+
+/*! Sets selected[i] to YES for each of the \p count methods which belongs to shard \p index of \p shardCount, given the stable hashes of their identifiers and, if \p balanced is YES, the identifiers themselves. */
+- (void)selectShard:(unsigned)index of:(unsigned)shardCount count:(unsigned)count hashes:(const uint32_t *)hashes
+        identifiers:(NSArray *)identifiers balanced:(BOOL)balanced selected:(BOOL *)selected;
+
+/*! Do the work for recordDuration:forMethod:ofClassName: and recordResult:forMethod:ofClassName: given the method's identifier. */
+- (void)recordDuration:(NSTimeInterval)seconds forIdentifier:(NSString *)identifier;
+- (void)recordResult:(BOOL)passed forIdentifier:(NSString *)identifier;
+
 /*! Check to see that the start date has been recorded. If it has not, record it. */
 - (void)checkStartDate;
 
+/*! Worker thread entry point used by runTestsForClassNames: takes class names off the front of \p queue until it is empty. */
+- (void)runQueuedTests:(NSMutableArray *)queue;
+
 /*! Helper method for optionally trimming path names before printing them to the console. */
 - (NSString *)trimmedPath:(char *)path;
 
+/*! Returns YES if a test with result \p passed will be logged by writePassed:inFile:atLine:message:, and so is worth formatting a message for. */
+- (BOOL)reportsResult:(BOOL)passed;
+
+/*! Logs where two unequal strings first differ, the text around that point, and a line-by-line comparison of the next few lines. The work done is proportional to the length of the common prefix plus the amount of text shown. */
+- (void)writeDifferencesFromString:(NSString *)expected toString:(NSString *)actual;
+
+/*! Logs the first few differences between two unequal arrays (see WO_DIFF_LIMIT) in place of their full descriptions. */
+- (void)writeDifferencesFromArray:(NSArray *)expected toArray:(NSArray *)actual;
+
+/*! Logs the first few keys which are missing from, unexpected in, or have a different value in \p actual. */
+- (void)writeDifferencesFromDictionary:(NSDictionary *)expected toDictionary:(NSDictionary *)actual;
+
 #pragma mark -
 #pragma mark Properties
 
@@ -177,16 +391,8 @@ OSStatus WOLowLevelExceptionHandler(ExceptionInformation *theException)
 // subdirectory.
 
 @property(readwrite, copy) NSDate   *startDate;
-@property(readwrite) unsigned       testsRun;
-@property(readwrite) unsigned       testsPassed;
-@property(readwrite) unsigned       testsFailed;
-@property(readwrite) unsigned       uncaughtExceptions;
-@property(readwrite) unsigned       testsFailedExpected;
-@property(readwrite) unsigned       testsPassedUnexpected;
-@property(readwrite) unsigned       lowLevelExceptionsExpected;
-@property(readwrite) unsigned       lowLevelExceptionsUnexpected;
-@property(readwrite, copy) NSString *lastReportedFile;
-@property(readwrite) int            lastReportedLine;
+@property(readwrite) BOOL           stopped;
+@property(readwrite) NSTimeInterval methodDiscoveryTime;
 
 //! \endgroup
 
@@ -218,8 +424,21 @@ OSStatus WOLowLevelExceptionHandler(ExceptionInformation *theException)
         if (!WOTestSharedInstance)          // first time here
         {
             if ((self = [super init]))
+            {
                 // once-off initialization and setting of defaults:
                 self->warnsAboutSignComparisons = YES;
+                self->catchesLowLevelExceptions = YES;
+                self->logsPassedTests           = YES;
+                pthread_key_create(&self->threadContextKey, NULL);
+                self->timings                   = [[NSMutableDictionary alloc] init];
+                self->failedMethods             = [[NSMutableSet alloc] init];
+                self->passedMethods             = [[NSMutableSet alloc] init];
+                self->classTimeouts             = [[NSMutableDictionary alloc] init];
+                self->runningMethods            = [[NSMutableDictionary alloc] init];
+                self->imageClassCache           = [[NSMutableDictionary alloc] init];
+                self->includedMethodFilters     = [[NSMutableArray alloc] init];
+                self->excludedMethodFilters     = [[NSMutableArray alloc] init];
+            }
             WOTestSharedInstance = self;
         }
         else
@@ -271,9 +490,10 @@ OSStatus WOLowLevelExceptionHandler(ExceptionInformation *theException)
             unsigned int originalLength = [description length];
             if (index > 0)  // a value of 0 would indicate that no truncation is to be performed
             {
-                description = [description WOTest_stringByCollapsingWhitespace];
-                if ([description length] > index)
-                    description = [[description substringToIndex:index] WOTest_stringByAppendingCharacter:WO_UNICODE_ELLIPSIS];
+                BOOL truncated = NO;
+                description = [description WOTest_stringByCollapsingWhitespaceTruncatedAt:index didTruncate:&truncated];
+                if (truncated)
+                    description = [description WOTest_stringByAppendingCharacter:WO_UNICODE_ELLIPSIS];
                 if (([description length] != originalLength) && (didTruncate))
                     *didTruncate = YES;
             }
@@ -328,13 +548,108 @@ OSStatus WOLowLevelExceptionHandler(ExceptionInformation *theException)
 
 - (BOOL)runAllTests
 {
-    int failures = 0;
     NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
-    for (NSString *class in [self testableClasses])
-        [self runTestsForClassName:class] ? : failures++;
+    BOOL noTestFailed = [self runTestsForClassNames:[self testableClasses]];
     [self printTestResultsSummary];
     [pool drain];
-    return (failures > 0) ? NO : YES;
+    return noTestFailed;
+}
+
+- (BOOL)runTestsForClassNames:(NSArray *)classNames
+{
+    return [self runTestsForClassNames:classNames methods:nil];
+}
+
+- (BOOL)runTestsForClassNames:(NSArray *)classNames methods:(NSDictionary *)methods
+{
+    NSParameterAssert(classNames != nil);
+    NSMutableDictionary *descriptors = nil;
+    if (methods)
+    {
+        // parse the names once, up front
+        descriptors = [NSMutableDictionary dictionaryWithCapacity:[methods count]];
+        for (NSString *class in methods)
+        {
+            Class aClass = NSClassFromString(class);
+            [descriptors setObject:(aClass ? [self descriptorsForMethods:[methods objectForKey:class] ofClass:aClass] : [NSData data])
+                            forKey:class];
+        }
+    }
+    return [self runTestsForClassNames:classNames descriptors:descriptors];
+}
+
+- (BOOL)runTestsForClassNames:(NSArray *)classNames descriptors:(NSDictionary *)descriptors
+{
+    NSParameterAssert(classNames != nil);
+    if (descriptors)
+    {
+        NSMutableArray *selected = [NSMutableArray arrayWithCapacity:[classNames count]];
+        for (NSString *class in classNames)
+            if ([descriptors objectForKey:class]) [selected addObject:class];
+        classNames = selected;
+    }
+    unsigned count = [classNames count];
+    if (self.jobs < 2 || count < 2)
+    {
+        int failures = 0;
+        for (NSString *class in classNames)
+        {
+            if (self.stopped) break;
+            [self runTestsForClass:NSClassFromString(class) descriptors:[descriptors objectForKey:class]] ? : failures++;
+        }
+        return (failures > 0) ? NO : YES;
+    }
+
+    [self checkStartDate];
+    NSMutableArray  *queue      = [NSMutableArray arrayWithArray:[self classNamesSortedByDuration:classNames]];
+    unsigned        threads     = MIN(self.jobs, count);
+    workerCondition             = [[NSCondition alloc] init];
+    workerFailures              = 0;
+    activeWorkers               = threads;
+    queuedDescriptors           = descriptors;
+    runningInParallel           = YES;
+    for (unsigned i = 0; i < threads; i++)
+        [NSThread detachNewThreadSelector:@selector(runQueuedTests:) toTarget:self withObject:queue];
+
+    // wait for the last worker to drain the queue
+    [workerCondition lock];
+    while (activeWorkers > 0)
+        [workerCondition wait];
+    [workerCondition unlock];
+    runningInParallel = NO;
+    queuedDescriptors = nil;
+    workerCondition = nil;
+    return (workerFailures > 0) ? NO : YES;
+}
+
+- (void)runQueuedTests:(NSMutableArray *)queue
+{
+    while (1)
+    {
+        NSAutoreleasePool   *pool       = [[NSAutoreleasePool alloc] init];
+        NSString            *className  = nil;
+        @synchronized (queue)
+        {
+            if ([queue count] > 0 && !self.stopped)
+            {
+                className = [queue objectAtIndex:0];
+                [queue removeObjectAtIndex:0];
+            }
+        }
+        if (className && ![self runTestsForClass:NSClassFromString(className) descriptors:[queuedDescriptors objectForKey:className]])
+        {
+            @synchronized (self)
+            {
+                workerFailures++;
+            }
+        }
+        [pool drain];
+        if (!className) break;
+    }
+    [workerCondition lock];
+    activeWorkers--;
+    [workerCondition signal];
+    [workerCondition unlock];
 }
 
 - (BOOL)runTestsForClassName:(NSString *)className
@@ -343,30 +658,64 @@ OSStatus WOLowLevelExceptionHandler(ExceptionInformation *theException)
     return [self runTestsForClass:NSClassFromString(className)];
 }
 
-// all other test-running methods ultimately get funnelled through this method
 - (BOOL)runTestsForClass:(Class)aClass
+{
+    return [self runTestsForClass:aClass methods:nil];
+}
+
+- (BOOL)runTestsForClass:(Class)aClass methods:(NSArray *)methods
+{
+    NSParameterAssert(aClass != nil);
+    return [self runTestsForClass:aClass descriptors:(methods ? [self descriptorsForMethods:methods ofClass:aClass] : nil)];
+}
+
+// all other test-running methods ultimately get funnelled through this method
+- (BOOL)runTestsForClass:(Class)aClass descriptors:(NSData *)methodDescriptors
 {
     NSParameterAssert(aClass != nil);
     [self checkStartDate];
-    BOOL    noTestFailed    = YES;
-    NSDate  *startClass     = [NSDate date];
+    BOOL                    noTestFailed    = YES;
+    NSString                *className      = NSStringFromClass(aClass);
+    NSDate                  *startClass     = [NSDate date];
     @try
     {
-        _WOLog(@"Running tests for class %@", NSStringFromClass(aClass));
+        _WOLog(@"Running tests for class %@", className);
         if ([NSObject WOTest_instancesOfClass:aClass conformToProtocol:@protocol(WOTest)])
         {
-            for (NSString *method in [self testableMethodsFrom:aClass])
+            NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+            NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+            NSTimeInterval timeout = [self timeoutForClassName:className];
+            if (!methodDescriptors)
+                methodDescriptors = [self testableMethodDescriptorsFrom:aClass];
+
+            // names and identifiers are only formatted when something needs them: the log (which is handed the selector name
+            // as is), notification observers (which get a WOTestMethodInfo that formats them on demand) and the per-method
+            // timings and results (one identifier per method)
+            const WOTestMethodDescriptor    *descriptors        = [methodDescriptors bytes];
+            unsigned                        descriptorCount     = [methodDescriptors length] / sizeof(WOTestMethodDescriptor);
+            for (unsigned i = 0; i < descriptorCount; i++)
             {
-                NSAutoreleasePool   *pool           = [[NSAutoreleasePool alloc] init];
-                NSDate              *startMethod    = [NSDate date];
-                SEL                 preflight       = @selector(preflight);
-                SEL                 postflight      = @selector(postflight);
-
-                _WOLog(@"Running test method %@", method);
+                if (self.stopped) break;
+                NSAutoreleasePool       *pool           = [[NSAutoreleasePool alloc] init];
+                WOTestMethodDescriptor  descriptor      = descriptors[i];
+                char                    kind            = descriptor.isClassMethod ? '+' : '-';
+                const char              *selectorName   = sel_getName(descriptor.selector);
+                CFAbsoluteTime          startMethod     = CFAbsoluteTimeGetCurrent();
+                SEL                     preflight       = @selector(preflight);
+                SEL                     postflight      = @selector(postflight);
+
+                _WOLog(@"Running test method %c%s", kind, selectorName);
+                [threadDictionary removeObjectForKey:WO_METHOD_FAILED_KEY];
+                [center postNotificationName:WO_TEST_WILL_RUN_METHOD_NOTIFICATION object:self
+                                    userInfo:[[WOTestMethodInfo alloc] initWithDescriptor:descriptor duration:nil failed:nil]];
+                if (timeout > 0.0)
+                    [self beginWatchingMethod:descriptor timeout:timeout];
                 @try
                 {
                     // minimize time spent with exception handlers in place
-                    [self installLowLevelExceptionHandler];
+                    // (the handler and jump buffer are process-wide so they can't be shared between worker threads)
+                    if (catchesLowLevelExceptions && !runningInParallel)
+                        [self installLowLevelExceptionHandler];
 
                     // record program counter and some other registers right now
 #ifdef __i386__
@@ -404,15 +753,15 @@ jump_point:
                         @throw [WOTestLowLevelException exceptionWithType:WOLastLowLevelException];
                     }
 
-                    if ([self isClassMethod:method])
+                    if (descriptor.isClassMethod)
                     {
                         if ([NSObject WOTest_class:aClass respondsToSelector:preflight])
                             objc_msgSend(aClass, preflight);
-                        objc_msgSend(aClass, [self selectorFromMethod:method]);
+                        objc_msgSend(aClass, descriptor.selector);
                         if ([NSObject WOTest_class:aClass respondsToSelector:postflight])
                             objc_msgSend(aClass, postflight);
                     }
-                    else if ([self isInstanceMethod:method])
+                    else
                     {
                         // class must implement alloc and init
                         if ([NSObject WOTest_object:aClass respondsToSelector:@selector(alloc)] &&
@@ -421,48 +770,55 @@ jump_point:
                             id instance = [[aClass alloc] init];
                             if ([NSObject WOTest_instancesOfClass:aClass respondToSelector:preflight])
                                 objc_msgSend(instance, preflight);
-                            objc_msgSend(instance, [self selectorFromMethod:method]);
+                            objc_msgSend(instance, descriptor.selector);
                             if ([NSObject WOTest_instancesOfClass:aClass respondToSelector:postflight])
                                 objc_msgSend(instance, postflight);
                         }
                         else
                         {
-                            [self writeError:@"Class %@ must respond to the alloc and init selectors",
-                                NSStringFromClass(aClass)];
+                            [self writeError:@"Class %@ must respond to the alloc and init selectors", className];
                             [self writeLastKnownLocation];
                         }
                     }
-                    else    // should never get here
-                        [self writeError:@"WOTest internal error"];
                 }
                 @catch (WOTestLowLevelException *lowLevelException)
                 {
                     if (self.expectLowLevelExceptions)
                     {
                         [self writeStatus:[lowLevelException reason]];    // expected low-level exceptions are not an error
-                        self.lowLevelExceptionsExpected++;
+                        WO_INCREMENT(lowLevelExceptionsExpected);
                     }
                     else
                     {
                         [self writeError:[lowLevelException reason]];     // unexpected low-level exceptions are an error
                         [self writeLastKnownLocation];
                         noTestFailed = NO;
-                        self.lowLevelExceptionsUnexpected++;
+                        WO_FAILURE(lowLevelExceptionsUnexpected);
                     }
+                    _WOLogFlush();
                 }
                 @catch (id e)
                 {
-                    [self writeError:@"uncaught exception (%@) in test method %@", [NSException WOTest_descriptionForException:e],
-                        method];
+                    [self writeError:@"uncaught exception (%@) in test method %c%s", [NSException WOTest_descriptionForException:e],
+                        kind, selectorName];
                     [self writeLastKnownLocation];
                     noTestFailed = NO;
-                    self.uncaughtExceptions++;
+                    WO_FAILURE(uncaughtExceptions);
                 }
                 @finally
                 {
                     if (lowLevelExceptionHandlerInstalled)
                         [self removeLowLevelExceptionHandler];
-                    _WOLog(@"Finished test method %@ (%.4f seconds)", method, -[startMethod timeIntervalSinceNow]);
+                    NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startMethod;
+                    _WOLog(@"Finished test method %c%s (%.4f seconds)", kind, selectorName, duration);
+                    BOOL timedOut = (timeout > 0.0) && [self endWatchingMethod];
+                    BOOL failed = timedOut || [[threadDictionary objectForKey:WO_METHOD_FAILED_KEY] boolValue];
+                    NSString *identifier = [self identifierForDescriptor:descriptor];
+                    [self recordDuration:duration forIdentifier:identifier];
+                    [self recordResult:!failed forIdentifier:identifier];
+                    WOTestMethodInfo *didRunInfo = [[WOTestMethodInfo alloc] initWithDescriptor:descriptor
+                        duration:[NSNumber numberWithDouble:duration] failed:[NSNumber numberWithBool:failed]];
+                    [center postNotificationName:WO_TEST_DID_RUN_METHOD_NOTIFICATION object:self userInfo:didRunInfo];
                     [pool drain];
                 }
             }
@@ -470,15 +826,14 @@ jump_point:
     }
     @catch (id e)
     {
-        [self writeError:@"uncaught exception (%@) testing class %@", [NSException WOTest_descriptionForException:e],
-            NSStringFromClass(aClass)];
+        [self writeError:@"uncaught exception (%@) testing class %@", [NSException WOTest_descriptionForException:e], className];
         [self writeLastKnownLocation];
         noTestFailed = NO;
-        self.uncaughtExceptions++;
+        WO_FAILURE(uncaughtExceptions);
     }
     @finally
     {
-        _WOLog(@"Finished tests for class %@ (%.4f seconds)", NSStringFromClass(aClass), -[startClass timeIntervalSinceNow]);
+        _WOLog(@"Finished tests for class %@ (%.4f seconds)", className, -[startClass timeIntervalSinceNow]);
     }
     return noTestFailed;
 }
@@ -486,177 +841,488 @@ jump_point:
 - (NSArray *)testableClasses
 {
     // return an array of class names
-    NSMutableArray *testableClasses = [NSMutableArray array];
+    NSMutableArray  *testableClasses    = [NSMutableArray array];
+    unsigned        counts[WOScanCountMax] = { 0 };
+    unsigned        imagesScanned       = 0;
+    unsigned        imagesSkipped       = 0;
+    unsigned        imagesFailed        = 0;
+
+    // only the classes of non-system images are examined (previously every class in the process was)
+    unsigned    imageCount  = 0;
+    const char  **images    = objc_copyImageNames(&imageCount);
+    if (images)
+    {
+        for (unsigned i = 0; i < imageCount; i++)
+        {
+            if (strncmp(images[i], "/System/", 8) == 0 || strncmp(images[i], "/usr/lib/", 9) == 0)
+            {
+                imagesSkipped++;
+                continue;
+            }
+            imagesScanned++;
 
-    unsigned    classCount                 = 0; // the total number of classes
-    unsigned    conformingClassCount       = 0; // classes conforming to WOTest
-    unsigned    nonconformingClassCount    = 0; // unconforming classes
-    unsigned    excludedClassCount         = 0; // excluded classes
-    unsigned    exceptionCount             = 0; // classes provoking exceptions
+            // one bad image shouldn't stop the others from being examined
+            @try
+            {
+                [testableClasses addObjectsFromArray:
+                    [self testableClassesInImage:[NSString stringWithUTF8String:images[i]] counts:counts]];
+            }
+            @catch (id e)
+            {
+                imagesFailed++;
+                _WOLog(@"Uncaught exception (%@) examining classes in %s", [NSException WOTest_descriptionForException:e],
+                       images[i]);
+            }
+        }
+        free(images);
+    }
 
-    int         numClasses                  = 0;
-    int         newNumClasses               = objc_getClassList(NULL, 0);
-    Class       *classes                    = NULL;
+    _WOLog(@"Runtime Summary:\n"
+           @"Images scanned (skipped, failed):                      %d (%d, %d)\n"
+           @"Images already examined (test classes they contain):   %d (%d)\n"
+           @"Total classes scanned:                                 %d\n"
+           @"Classes which conform to the WOTest protocol:          %d\n"
+           @"Classes which do not conform to the protocol:          %d\n"
+           @"Classes excluded from scanning:                        %d\n"
+           @"Classes that could not be scanned due to exceptions:   %d",
+           imagesScanned - counts[WOScanCachedImages] - imagesFailed, imagesSkipped, imagesFailed,
+           counts[WOScanCachedImages], counts[WOScanCachedClasses],
+           counts[WOScanTotal],
+           counts[WOScanConforming],
+           counts[WOScanNonconforming],
+           counts[WOScanExcluded],
+           counts[WOScanExceptions]);
 
-    // get a list of all classes on the system
-    while (numClasses < newNumClasses)
-    {
-        numClasses          = newNumClasses;
-        size_t bufferSize   = sizeof(Class) * numClasses;
-        classes             = realloc(classes, bufferSize);
-        NSAssert1((classes != NULL), @"realloc() failed (size %d)", bufferSize);
-        newNumClasses       = objc_getClassList(classes, numClasses);
-    }
+    return [testableClasses sortedArrayUsingSelector:@selector(compare:)];
+}
 
-    @try
+- (NSArray *)testableClassesInImage:(NSString *)imagePath
+{
+    return [self testableClassesInImage:imagePath counts:NULL];
+}
+
+- (NSArray *)testableClassesInImage:(NSString *)imagePath counts:(unsigned *)counts
+{
+    NSParameterAssert(imagePath != nil);
+    @synchronized (imageClassCache)
     {
-        if (classes)
+        NSArray *cached = [imageClassCache objectForKey:imagePath];
+        if (cached)
         {
-            // skip over some classes because they not only cause exceptions but also spew out ugly console messages
-            SInt32 systemVersion;
-            Gestalt(gestaltSystemVersion, &systemVersion);
-            systemVersion = systemVersion & 0x0000ffff; // Apple instructs to ignore the high-order word
+            if (counts)
+            {
+                counts[WOScanCachedImages]++;
+                counts[WOScanCachedClasses] += [cached count];
+            }
+            return cached;
+        }
+    }
 
-            NSArray *excludedClasses = (systemVersion < 0x00001040) ?
-                [NSArray arrayWithObjects: @"Protocol", @"List", @"Object", @"_NSZombie", nil] :                        // 10.3
-                [NSArray arrayWithObjects: @"Protocol", @"List", @"Object", @"_NSZombie", @"NSATSGlyphGenerator", nil]; // 10.4
+    NSMutableArray *testableClasses = [NSMutableArray array];
+    unsigned scratch[WOScanCountMax] = { 0 };
+    if (!counts)
+        counts = scratch;
 
-            if (self.verbosity > 1)
-                _WOLog(@"Examining classes for WOTest protocol compliance");
+    // skip over some classes because they not only cause exceptions but also spew out ugly console messages
+    NSSet *excludedClasses = [NSSet setWithObjects:@"Protocol", @"List", @"Object", @"_NSZombie", @"NSATSGlyphGenerator", nil];
 
-            for (int i = 0; i < newNumClasses; i++)
-            {
-                classCount++;
+    if (self.verbosity > 1)
+        _WOLog(@"Examining classes in %@ for WOTest protocol compliance", imagePath);
 
-                Class       aClass      = classes[i];
-                NSString    *className  = NSStringFromClass(aClass);
+    // classes registered at link time spare us from looking at every class in the image
+    NSArray *classNames = [self registeredClassesInImage:imagePath];
+    if (classNames)
+    {
+        if (self.verbosity > 1)
+            _WOLog(@"Using %d classes registered in %@", (int)[classNames count], imagePath);
+    }
+    else
+    {
+        unsigned    classCount  = 0;
+        const char  **names     = objc_copyClassNamesForImage([imagePath fileSystemRepresentation], &classCount);
+        NSMutableArray *imageClassNames = [NSMutableArray arrayWithCapacity:classCount];
+        for (unsigned i = 0; i < classCount; i++)
+            [imageClassNames addObject:[NSString stringWithUTF8String:names[i]]];
+        free(names);
+        classNames = imageClassNames;
+    }
 
-                @try
-                {
-                    if ([excludedClasses containsObject:className])
-                    {
-                        excludedClassCount++;
-                        if (self.verbosity > 1)
-                            _WOLog(@"Skipping class %@ (appears in exclusion list)", className);
-                    }
-                    else if ([NSObject WOTest_instancesOfClass:aClass conformToProtocol:@protocol(WOTest)])
-                    {
-                        conformingClassCount++;
-                        [testableClasses addObject:className];
-                        if (self.verbosity > 0)
-                            _WOLog(@"Class %@ complies with the WOTest protocol", className);
-                    }
-                    else
-                    {
-                        nonconformingClassCount++;
-                        if (self.verbosity > 1)
-                            _WOLog(@"Class %@ does not comply with the WOTest protocol", className);
-                    }
-                }
-                @catch (id exception)
-                {
-                    exceptionCount++;
-                    // a number of classes are known to provoke exceptions:
-                    if (self.verbosity > 1)
-                        _WOLog(@"Cannot test protocol compliance for class %@ (caught exception)", className);
-                    continue;
-                }
+    for (NSString *className in classNames)
+    {
+        counts[WOScanTotal]++;
+        @try
+        {
+            Class aClass = NSClassFromString(className);
+            if (!aClass || [excludedClasses containsObject:className])
+            {
+                counts[WOScanExcluded]++;
+                if (self.verbosity > 1)
+                    _WOLog(@"Skipping class %@ (appears in exclusion list)", className);
+            }
+            else if ([NSObject WOTest_instancesOfClass:aClass conformToProtocol:@protocol(WOTest)])
+            {
+                counts[WOScanConforming]++;
+                [testableClasses addObject:className];
+                if (self.verbosity > 0)
+                    _WOLog(@"Class %@ complies with the WOTest protocol", className);
+            }
+            else
+            {
+                counts[WOScanNonconforming]++;
+                if (self.verbosity > 1)
+                    _WOLog(@"Class %@ does not comply with the WOTest protocol", className);
             }
-            free(classes);
         }
-
+        @catch (id exception)
+        {
+            counts[WOScanExceptions]++;
+            // a number of classes are known to provoke exceptions:
+            if (self.verbosity > 1)
+                _WOLog(@"Cannot test protocol compliance for class %@ (caught exception)", className);
+        }
     }
-    @catch (id e)
+
+    NSArray *result = [testableClasses sortedArrayUsingSelector:@selector(compare:)];
+    @synchronized (imageClassCache)
     {
-        _WOLog(@"Uncaught exception...");
+        [imageClassCache setObject:result forKey:imagePath];
     }
+    return result;
+}
 
-    _WOLog(@"Runtime Summary:\n"
-           @"Total classes:                                         %d\n"
-           @"Classes which conform to the WOTest protocol:          %d\n"
-           @"Classes which do not conform to the protocol:          %d\n"
-           @"Classes excluded from scanning:                        %d\n"
-           @"Classes that could not be scanned due to exceptions:   %d",
-           classCount,
-           conformingClassCount,
-           nonconformingClassCount,
-           excludedClassCount,
-           exceptionCount);
+- (NSArray *)registeredClassesInImage:(NSString *)imagePath
+{
+    NSParameterAssert(imagePath != nil);
+    const char *image = [imagePath fileSystemRepresentation];
+    for (uint32_t i = 0, max = _dyld_image_count(); i < max; i++)
+    {
+        const char *name = _dyld_get_image_name(i);
+        if (!name || strcmp(name, image) != 0) continue;
 
-    return [testableClasses sortedArrayUsingSelector:@selector(compare:)];
+        // the section holds one (relocated) pointer to a class name per registered class
+        unsigned long size = 0;
+#ifdef __LP64__
+        const struct mach_header_64 *header = (const struct mach_header_64 *)_dyld_get_image_header(i);
+#else
+        const struct mach_header    *header = _dyld_get_image_header(i);
+#endif
+        const char **entries = (const char **)getsectiondata(header, "__DATA", WO_TEST_REGISTRATION_SECTION, &size);
+        if (!entries)
+            return nil;
+        NSMutableArray *classNames = [NSMutableArray array];
+        for (unsigned long j = 0, count = size / sizeof(const char *); j < count; j++)
+            if (entries[j])
+                [classNames addObject:[NSString stringWithUTF8String:entries[j]]];
+        return classNames;
+    }
+    return nil;
 }
 
-- (NSArray *)testableClassesFrom:(NSBundle *)aBundle
+- (NSString *)imageNameForBundle:(NSBundle *)aBundle
 {
-    NSMutableArray  *classNames = [NSMutableArray array];
+    NSString *executable = [[aBundle executablePath] stringByResolvingSymlinksInPath];
+    if (!executable)
+        return nil;
 
-    if (aBundle)    // only search if actually passed a non-nil bundle
+    // the runtime may know the image by a different (unresolved or relative) path to the one NSBundle reports
+    NSString    *imageName  = nil;
+    unsigned    imageCount  = 0;
+    const char  **images    = objc_copyImageNames(&imageCount);
+    if (images)
     {
-        // add only classes that match the passed bundle and conform to WOTest
-        for (NSString *className in [self testableClasses])
+        for (unsigned i = 0; i < imageCount && !imageName; i++)
         {
-            Class       aClass          = NSClassFromString(className);
-            NSBundle    *classBundle    = [NSBundle bundleForClass:aClass];
-            if ([classBundle isEqualTo:aBundle])
-                [classNames addObject:className];
+            NSString *candidate = [NSString stringWithUTF8String:images[i]];
+            if ([candidate isEqualToString:executable] ||
+                [[candidate stringByResolvingSymlinksInPath] isEqualToString:executable])
+                imageName = candidate;
         }
+        free(images);
     }
+    return imageName;
+}
 
-    return [classNames copy];   // return immutable
+- (NSArray *)testableClassesFrom:(NSBundle *)aBundle
+{
+    if (!aBundle)   // only search if actually passed a non-nil bundle
+        return [NSArray array];
+    NSString *imageName = [self imageNameForBundle:aBundle];
+    return imageName ? [self testableClassesInImage:imageName] : [NSArray array];
 }
 
 - (NSArray *)testableMethodsFrom:(Class)aClass
+{
+    return [self methodNamesForDescriptors:[self testableMethodDescriptorsFrom:aClass]];
+}
+
+- (NSArray *)selectedMethodsFrom:(Class)aClass
+{
+    return [self methodNamesForDescriptors:[self selectedMethodDescriptorsFrom:aClass]];
+}
+
+- (NSData *)testableMethodDescriptorsFrom:(Class)aClass
+{
+    unsigned                count;
+    WOTestMethodDescriptor  *descriptors = [self copyTestableMethodDescriptorsFrom:aClass count:&count];
+    return [NSData dataWithBytesNoCopy:descriptors length:(count * sizeof(WOTestMethodDescriptor)) freeWhenDone:YES];
+}
+
+- (NSData *)selectedMethodDescriptorsFrom:(Class)aClass
+{
+    NSData *testable = [self testableMethodDescriptorsFrom:aClass];
+    BOOL filtered;
+    @synchronized (includedMethodFilters)
+    {
+        filtered = ([includedMethodFilters count] + [excludedMethodFilters count]) > 0;
+    }
+    if (!filtered)
+        return testable;
+
+    const WOTestMethodDescriptor    *descriptors    = [testable bytes];
+    unsigned                        count           = [testable length] / sizeof(WOTestMethodDescriptor);
+    NSMutableData                   *selected       = [NSMutableData dataWithCapacity:[testable length]];
+    for (unsigned i = 0; i < count; i++)
+    {
+        // build the "Class/-method" identifier without going through NSString
+        const char  *className  = class_getName(descriptors[i].testClass);
+        const char  *name       = sel_getName(descriptors[i].selector);
+        char        buffer[256];
+        size_t      length      = strlen(className) + strlen(name) + 3;
+        char        *identifier = (length <= sizeof(buffer)) ? buffer : malloc(length);
+        snprintf(identifier, length, "%s/%c%s", className, descriptors[i].isClassMethod ? '+' : '-', name);
+        BOOL passes = [self methodIdentifierPassesFilters:identifier];
+        if (identifier != buffer)
+            free(identifier);
+        if (passes)
+            [selected appendBytes:&descriptors[i] length:sizeof(WOTestMethodDescriptor)];
+    }
+    return selected;
+}
+
+- (NSData *)descriptorsForMethods:(NSArray *)methods ofClass:(Class)aClass
+{
+    unsigned                count;
+    WOTestMethodDescriptor  *descriptors = [self copyDescriptorsForMethods:methods ofClass:aClass count:&count];
+    return [NSData dataWithBytesNoCopy:descriptors length:(count * sizeof(WOTestMethodDescriptor)) freeWhenDone:YES];
+}
+
+- (NSArray *)methodNamesForDescriptors:(NSData *)descriptors
+{
+    NSParameterAssert(descriptors != nil);
+    const WOTestMethodDescriptor    *bytes          = [descriptors bytes];
+    unsigned                        count           = [descriptors length] / sizeof(WOTestMethodDescriptor);
+    NSMutableArray                  *methodNames    = [NSMutableArray arrayWithCapacity:count];
+    for (unsigned i = 0; i < count; i++)
+        [methodNames addObject:[self methodNameForDescriptor:bytes[i]]];
+    return methodNames;
+}
+
+// orders descriptors as their "+name" and "-name" strings would sort: class methods first, then by selector name
+static int WOCompareDescriptors(const void *a, const void *b)
+{
+    const WOTestMethodDescriptor *first     = a;
+    const WOTestMethodDescriptor *second    = b;
+    if (first->isClassMethod != second->isClassMethod)
+        return first->isClassMethod ? -1 : 1;
+    return strcmp(sel_getName(first->selector), sel_getName(second->selector));
+}
+
+- (WOTestMethodDescriptor *)copyTestableMethodDescriptorsFrom:(Class)aClass count:(unsigned *)count
 {
     // catch crashes caused by passing an "id" instead of a "Class"
     NSParameterAssert([NSObject WOTest_isRegisteredClass:aClass] || [NSObject WOTest_isMetaClass:aClass]);
+    NSParameterAssert(count != NULL);
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+
+    // passing a metaclass yields only the class methods
+    BOOL        onlyClassMethods    = class_isMetaClass(aClass);
+    const char  *className          = class_getName(aClass);    // metaclasses have the same name as their classes
+    Class       testClass           = onlyClassMethods ? objc_getClass(className) : aClass;
+
+    unsigned    classMethodCount    = 0;
+    unsigned    instanceMethodCount = 0;
+    Method      *classMethods       = class_copyMethodList(object_getClass(testClass), &classMethodCount);
+    Method      *instanceMethods    = onlyClassMethods ? NULL : class_copyMethodList(testClass, &instanceMethodCount);
+    WOTestMethodDescriptor *descriptors = malloc(sizeof(WOTestMethodDescriptor) * (classMethodCount + instanceMethodCount + 1));
+    NSAssert(descriptors != NULL, @"malloc() failed");
+
+    unsigned found = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        BOOL        isClassMethod   = (pass == 0);
+        Method      *methods        = isClassMethod ? classMethods : instanceMethods;
+        unsigned    methodCount     = isClassMethod ? classMethodCount : instanceMethodCount;
+        for (unsigned i = 0; i < methodCount; i++)
+        {
+            SEL         aSelector   = method_getName(methods[i]);
+            const char  *name       = sel_getName(aSelector);
+            if (!name || strncmp(name, "test", 4) != 0)
+                continue;
+            descriptors[found].testClass        = testClass;
+            descriptors[found].selector         = aSelector;
+            descriptors[found].isClassMethod    = isClassMethod;
+            descriptors[found].order            = found;    // before sorting, so this is the order of the method lists
+            found++;
+        }
+    }
+    free(classMethods);
+    free(instanceMethods);
 
-    NSMutableArray *methodNames = [NSMutableArray array];
-    @try
+    qsort(descriptors, found, sizeof(WOTestMethodDescriptor), WOCompareDescriptors);
+    *count = found;
+    @synchronized (self)
+    {
+        self.methodDiscoveryTime += CFAbsoluteTimeGetCurrent() - start;
+    }
+    return descriptors;
+}
+
+- (WOTestMethodDescriptor *)copyDescriptorsForMethods:(NSArray *)methods ofClass:(Class)aClass count:(unsigned *)count
+{
+    NSParameterAssert(methods != nil);
+    NSParameterAssert(aClass != nil);
+    NSParameterAssert(count != NULL);
+    WOTestMethodDescriptor *descriptors = malloc(sizeof(WOTestMethodDescriptor) * ([methods count] + 1));
+    NSAssert(descriptors != NULL, @"malloc() failed");
+    unsigned found = 0;
+    for (NSString *method in methods)
     {
-        NSString *prefix = @"-";            // default prefix (instance methods)
-        if (class_isMetaClass(aClass))
-            prefix = @"+";                  // special prefix (class methods)
-        else                                // this is not a metaclass
+        BOOL isClassMethod = [self isClassMethod:method];
+        if ((!isClassMethod && ![self isInstanceMethod:method]) || [method length] < 2)
         {
-            // get the metaclass; could also use object_getClass
-            Class   metaClass       = object_getClass(aClass);
-            NSArray *classMethods   = [self testableMethodsFrom:metaClass];
-            [methodNames addObjectsFromArray:classMethods];
+            [self writeError:@"invalid test method name \"%@\" for class %@", method, NSStringFromClass(aClass)];
+            continue;
         }
+        descriptors[found].testClass        = aClass;
+        descriptors[found].selector         = [self selectorFromMethod:method];
+        descriptors[found].isClassMethod    = isClassMethod;
+        descriptors[found].order            = found;
+        found++;
+    }
+    *count = found;
+    return descriptors;
+}
+
+- (NSString *)methodNameForDescriptor:(WOTestMethodDescriptor)descriptor
+{
+    return [NSString stringWithFormat:@"%c%s", descriptor.isClassMethod ? '+' : '-', sel_getName(descriptor.selector)];
+}
 
-        unsigned int count;
-        Method *methods = class_copyMethodList(aClass, &count);
-        if (methods)
+- (NSString *)identifierForDescriptor:(WOTestMethodDescriptor)descriptor
+{
+    return [NSString stringWithFormat:@"%s/%c%s", class_getName(descriptor.testClass), descriptor.isClassMethod ? '+' : '-',
+        sel_getName(descriptor.selector)];
+}
+
+// compiles pattern into an NSData object wrapping a WOMethodFilter; raises an NSInvalidArgumentException if it can't be compiled
+static NSData *WOMethodFilterCreate(NSString *pattern)
+{
+    NSMutableData   *data       = [NSMutableData dataWithLength:sizeof(WOMethodFilter)];
+    WOMethodFilter  *filter     = [data mutableBytes];
+    NSUInteger      length      = [pattern length];
+    if (length > 2 && [pattern hasPrefix:@"/"] && [pattern hasSuffix:@"/"])
+    {
+        filter->isRegex = YES;
+        NSString *expression = [pattern substringWithRange:NSMakeRange(1, length - 2)];
+        int error = regcomp(&filter->regex, [expression UTF8String], REG_EXTENDED | REG_NOSUB);
+        if (error)
         {
-            for (unsigned int i = 0, max = count; i < max; i++)
-            {
-                SEL         aSelector   = method_getName(methods[i]);
-                NSString    *name       = NSStringFromSelector(aSelector);
-                if (name && [name hasPrefix:@"test"])
-                    [methodNames addObject:[NSString stringWithFormat:@"%@%@", prefix, name]];
-            }
-            free(methods);
+            char message[256];
+            regerror(error, &filter->regex, message, sizeof(message));
+            [NSException raise:NSInvalidArgumentException format:@"invalid regular expression %@ (%s)", pattern, message];
         }
     }
-    @catch (id e)
+    else
     {
-        NSString *error = [NSString stringWithFormat:@"exception caught trying to identify testable methods in class %@",
-            NSStringFromClass(aClass)];
-        [self writeError:error];
+        // globs without a class part apply to every class
+        if ([pattern rangeOfString:@"/"].location == NSNotFound)
+            pattern = [@"*/" stringByAppendingString:pattern];
+        const char *glob = [pattern UTF8String];
+        if (strlcpy(filter->glob, glob, sizeof(filter->glob)) >= sizeof(filter->glob))
+            [NSException raise:NSInvalidArgumentException format:@"method pattern too long: %@", pattern];
     }
+    return data;
+}
+
+static void WOMethodFilterFree(NSData *data)
+{
+    const WOMethodFilter *filter = [data bytes];
+    if (filter->isRegex)
+        regfree((regex_t *)&filter->regex);
+}
+
+static BOOL WOMethodFilterMatches(NSData *data, const char *identifier)
+{
+    const WOMethodFilter *filter = [data bytes];
+    if (filter->isRegex)
+        return (regexec(&filter->regex, identifier, 0, NULL, 0) == 0);
+    return (fnmatch(filter->glob, identifier, 0) == 0);
+}
+
+- (BOOL)method:(NSString *)method ofClassName:(NSString *)className matchesPattern:(NSString *)pattern
+{
+    NSParameterAssert(pattern != nil);
+    NSData *filter = WOMethodFilterCreate(pattern);
+    BOOL matches = WOMethodFilterMatches(filter, [[self identifierForMethod:method ofClassName:className] UTF8String]);
+    WOMethodFilterFree(filter);
+    return matches;
+}
 
-    return [methodNames sortedArrayUsingSelector:@selector(compare:)];
+- (BOOL)method:(NSString *)method passesFiltersForClassName:(NSString *)className
+{
+    return [self methodIdentifierPassesFilters:[[self identifierForMethod:method ofClassName:className] UTF8String]];
+}
+
+- (BOOL)methodIdentifierPassesFilters:(const char *)identifier
+{
+    NSParameterAssert(identifier != NULL);
+    @synchronized (includedMethodFilters)
+    {
+        for (NSArray *entry in excludedMethodFilters)
+            if (WOMethodFilterMatches([entry objectAtIndex:1], identifier)) return NO;
+        if ([includedMethodFilters count] == 0)
+            return YES;
+        for (NSArray *entry in includedMethodFilters)
+            if (WOMethodFilterMatches([entry objectAtIndex:1], identifier)) return YES;
+    }
+    return NO;
+}
+
+- (void)addMethodFilter:(NSString *)pattern excluding:(BOOL)exclude
+{
+    NSParameterAssert(pattern != nil);
+    NSData *filter = WOMethodFilterCreate(pattern);
+    @synchronized (includedMethodFilters)
+    {
+        [(exclude ? excludedMethodFilters : includedMethodFilters) addObject:[NSArray arrayWithObjects:pattern, filter, nil]];
+    }
+}
+
+- (void)removeMethodFilter:(NSString *)pattern excluding:(BOOL)exclude
+{
+    NSParameterAssert(pattern != nil);
+    @synchronized (includedMethodFilters)
+    {
+        NSMutableArray *filters = exclude ? excludedMethodFilters : includedMethodFilters;
+        for (NSArray *entry in [NSArray arrayWithArray:filters])
+        {
+            if (![[entry objectAtIndex:0] isEqualToString:pattern]) continue;
+            WOMethodFilterFree([entry objectAtIndex:1]);
+            [filters removeObject:entry];
+        }
+    }
 }
 
 - (void)printTestResultsSummary;
 {
     [self checkStartDate];  // just in case no tests were run, make sure that startDate is non-nil
+    WOTestResults results = [self results];
     double      successRate = 0.0;
     double      failureRate = 0.0;
-    if (self.testsRun > 0)  // watch out for divide-by-zero if no tests run
+    if (results.testsRun > 0)   // watch out for divide-by-zero if no tests run
     {
-        successRate = ((double)(self.testsPassed + self.testsFailedExpected)    / (double)self.testsRun) * 100.0;
-        failureRate = ((double)(self.testsFailed + self.testsPassedUnexpected)  / (double)self.testsRun) * 100.0;
+        successRate = ((double)(results.testsPassed + results.testsFailedExpected)    / (double)results.testsRun) * 100.0;
+        failureRate = ((double)(results.testsFailed + results.testsPassedUnexpected)  / (double)results.testsRun) * 100.0;
     }
     _WOLog(@"Run summary:\n"
            @"Tests run:                         %d\n"
@@ -665,14 +1331,14 @@ jump_point:
            @"Uncaught exceptions:               %d\n"
            @"Low-level exceptions (crashers):   %d + %d expected\n"
            @"Total run time:                    %.2f seconds\n",
-           self.testsRun,
-           self.testsPassed,    self.testsFailedExpected,   successRate,
-           self.testsFailed,    self.testsPassedUnexpected, failureRate,
-           self.uncaughtExceptions,
-           self.lowLevelExceptionsUnexpected,   self.lowLevelExceptionsExpected,
+           results.testsRun,
+           results.testsPassed, results.testsFailedExpected,    successRate,
+           results.testsFailed, results.testsPassedUnexpected,  failureRate,
+           results.uncaughtExceptions,
+           results.lowLevelExceptionsUnexpected,    results.lowLevelExceptionsExpected,
            -[self.startDate timeIntervalSinceNow]);
 
-    if (self.testsRun == 0)
+    if (results.testsRun == 0)
         _WOLog(@"warning: no tests were run\n");
 
     // TODO: make Growl notifications optional
@@ -680,7 +1346,7 @@ jump_point:
     // TODO: add options for showing coalesced growl notifications showing individual test failures (with path and line info)
     // TODO: make clicking on notification bring Xcode to the front, or open the file with the last failure in it etc
     NSString *status = [NSString stringWithFormat:@"%d tests passed, %d tests failed",
-        self.testsPassed + self.testsFailedExpected, self.testsFailed + self.testsPassedUnexpected];
+        results.testsPassed + results.testsFailedExpected, results.testsFailed + results.testsPassedUnexpected];
 
     if ([self testsWereSuccessful])
         [self growlNotifyTitle:@"WOTest run successful" message:status isWarning:NO sticky:NO];
@@ -697,7 +1363,524 @@ jump_point:
 
 - (BOOL)testsWereSuccessful
 {
-    return ((self.testsFailed + self.testsPassedUnexpected + self.uncaughtExceptions + self.lowLevelExceptionsUnexpected) == 0);
+    WOTestResults results = [self results];
+    return ((results.testsFailed + results.testsPassedUnexpected + results.uncaughtExceptions +
+             results.lowLevelExceptionsUnexpected) == 0);
+}
+
+- (WOTestResults)results
+{
+    // counts for threads which are still running may be slightly out of date, but nothing is ever lost
+    WOTestResults results;
+    memset(&results, 0, sizeof(results));
+    OSMemoryBarrier();
+    for (WOTestThreadContext *context = threadContexts; context; context = context->next)
+        WOAddResults(&results, &context->results);
+    return results;
+}
+
+- (WOTestResults)resultsForCurrentThread
+{
+    return WO_THREAD_CONTEXT->results;
+}
+
+- (void)addResults:(WOTestResults)results
+{
+    [self checkStartDate];
+    WOAddResults(&WO_THREAD_CONTEXT->results, &results);
+}
+
+- (unsigned)testsRun
+{
+    return [self results].testsRun;
+}
+
+- (unsigned)testsPassed
+{
+    return [self results].testsPassed;
+}
+
+- (unsigned)testsFailed
+{
+    return [self results].testsFailed;
+}
+
+- (unsigned)uncaughtExceptions
+{
+    return [self results].uncaughtExceptions;
+}
+
+- (unsigned)testsFailedExpected
+{
+    return [self results].testsFailedExpected;
+}
+
+- (unsigned)testsPassedUnexpected
+{
+    return [self results].testsPassedUnexpected;
+}
+
+- (unsigned)lowLevelExceptionsExpected
+{
+    return [self results].lowLevelExceptionsExpected;
+}
+
+- (unsigned)lowLevelExceptionsUnexpected
+{
+    return [self results].lowLevelExceptionsUnexpected;
+}
+
+- (BOOL)expectFailures
+{
+    return WO_THREAD_CONTEXT->expectFailures;
+}
+
+- (void)setExpectFailures:(BOOL)flag
+{
+    WO_THREAD_CONTEXT->expectFailures = flag;
+}
+
+#pragma mark -
+#pragma mark Per-method results
+
+- (void)recordResult:(BOOL)passed forMethod:(NSString *)method ofClassName:(NSString *)className
+{
+    [self recordResult:passed forIdentifier:[self identifierForMethod:method ofClassName:className]];
+}
+
+- (void)recordResult:(BOOL)passed forIdentifier:(NSString *)identifier
+{
+    @synchronized (failedMethods)
+    {
+        if (passed)
+            [passedMethods addObject:identifier];
+        else
+        {
+            [failedMethods addObject:identifier];
+            if (self.stopsAfterFirstFailure)
+                self.stopped = YES;
+        }
+    }
+}
+
+- (NSSet *)failedMethods
+{
+    @synchronized (failedMethods)
+    {
+        return [NSSet setWithSet:failedMethods];
+    }
+}
+
+- (NSSet *)passedMethods
+{
+    @synchronized (failedMethods)
+    {
+        return [NSSet setWithSet:passedMethods];
+    }
+}
+
+#pragma mark -
+#pragma mark Timing methods
+
+- (NSString *)identifierForMethod:(NSString *)method ofClassName:(NSString *)className
+{
+    NSParameterAssert(method != nil);
+    NSParameterAssert(className != nil);
+    return [NSString stringWithFormat:@"%@/%@", className, method];
+}
+
+- (void)recordDuration:(NSTimeInterval)seconds forMethod:(NSString *)method ofClassName:(NSString *)className
+{
+    [self recordDuration:seconds forIdentifier:[self identifierForMethod:method ofClassName:className]];
+}
+
+- (void)recordDuration:(NSTimeInterval)seconds forIdentifier:(NSString *)identifier
+{
+    @synchronized (timings)
+    {
+        [timings setObject:[NSNumber numberWithDouble:seconds] forKey:identifier];
+    }
+}
+
+- (void)setTimeout:(NSTimeInterval)seconds forClassName:(NSString *)className
+{
+    NSParameterAssert(className != nil);
+    @synchronized (classTimeouts)
+    {
+        [classTimeouts setObject:[NSNumber numberWithDouble:seconds] forKey:className];
+    }
+}
+
+- (NSTimeInterval)timeoutForClassName:(NSString *)className
+{
+    NSParameterAssert(className != nil);
+    @synchronized (classTimeouts)
+    {
+        NSNumber *timeout = [classTimeouts objectForKey:className];
+        if (timeout)
+            return [timeout doubleValue];
+    }
+    return self.defaultTimeout;
+}
+
+- (void)beginWatchingMethod:(WOTestMethodDescriptor)descriptor timeout:(NSTimeInterval)timeout
+{
+    NSParameterAssert(timeout > 0.0);
+    NSMutableDictionary *record = [NSMutableDictionary dictionaryWithObjectsAndKeys:
+        NSStringFromClass(descriptor.testClass),        WO_TEST_CLASS_NAME_KEY,
+        [self methodNameForDescriptor:descriptor],      WO_TEST_METHOD_KEY,
+        [NSNumber numberWithDouble:timeout],            @"timeout",
+        [NSDate dateWithTimeIntervalSinceNow:timeout],  @"deadline",
+        [NSValue valueWithPointer:WO_THREAD_CONTEXT],   @"context", nil];
+    @synchronized (runningMethods)
+    {
+        [runningMethods setObject:record forKey:[NSValue valueWithPointer:[NSThread currentThread]]];
+        if (!watchdogStarted)
+        {
+            watchdogStarted = YES;
+            [NSThread detachNewThreadSelector:@selector(runWatchdog:) toTarget:self withObject:nil];
+        }
+    }
+}
+
+- (BOOL)endWatchingMethod
+{
+    NSValue *key = [NSValue valueWithPointer:[NSThread currentThread]];
+    @synchronized (runningMethods)
+    {
+        NSDictionary *record = [runningMethods objectForKey:key];
+        if (!record)
+            return NO;
+        BOOL timedOut = [[record objectForKey:@"timedOut"] boolValue];
+        [runningMethods removeObjectForKey:key];
+        return timedOut;
+    }
+}
+
+- (void)runWatchdog:(id)sender
+{
+    while (1)
+    {
+        NSAutoreleasePool   *pool       = [[NSAutoreleasePool alloc] init];
+        NSDate              *now        = [NSDate date];
+        NSMutableArray      *timedOut   = [NSMutableArray array];
+        @synchronized (runningMethods)
+        {
+            for (NSValue *key in runningMethods)
+            {
+                NSMutableDictionary *record = [runningMethods objectForKey:key];
+                if ([[record objectForKey:@"timedOut"] boolValue] ||
+                    [now compare:[record objectForKey:@"deadline"]] == NSOrderedAscending)
+                    continue;
+                [record setObject:[NSNumber numberWithBool:YES] forKey:@"timedOut"];
+                [timedOut addObject:record];
+            }
+        }
+
+        // report outside the lock: writing errors waits for the log to drain, and test threads need the lock to start and
+        // finish every method
+        for (NSDictionary *record in timedOut)
+        {
+            [self writeError:@"test method %@ of class %@ exceeded its time budget of %.1f seconds",
+                [record objectForKey:WO_TEST_METHOD_KEY], [record objectForKey:WO_TEST_CLASS_NAME_KEY],
+                [[record objectForKey:@"timeout"] doubleValue]];
+            // a timeout counts as one failed test of the hung method, in its own thread's context (honouring that thread's
+            // expectFailures setting like any other failure); the method's thread may still be counting, so this is atomic
+            WOTestThreadContext *context = [[record objectForKey:@"context"] pointerValue];
+            [self writeLastKnownLocationInContext:context];
+            WO_INCREMENT_IN(context, testsRun);
+            if (context->expectFailures)
+                WO_INCREMENT_IN(context, testsFailedExpected);
+            else
+                WO_INCREMENT_IN(context, testsFailed);
+            if (self.exitsOnTimeout)
+            {
+                // the hung method can't be interrupted from here; let the supervising process take over
+                _WOLogFlush();
+                fflush(NULL);
+                _exit(EXIT_FAILURE);
+            }
+        }
+        [pool drain];
+        [NSThread sleepForTimeInterval:WO_WATCHDOG_INTERVAL];
+    }
+}
+
+- (NSTimeInterval)durationForClassName:(NSString *)className
+{
+    NSParameterAssert(className != nil);
+    NSString        *prefix = [className stringByAppendingString:@"/"];
+    NSTimeInterval  total   = 0.0;
+    BOOL            found   = NO;
+    @synchronized (timings)
+    {
+        for (NSString *identifier in timings)
+        {
+            if (![identifier hasPrefix:prefix]) continue;
+            total += [[timings objectForKey:identifier] doubleValue];
+            found = YES;
+        }
+    }
+    return found ? total : -1.0;
+}
+
+// sorts longest first; unknown (negative) durations sort before everything else
+static NSInteger WOCompareDurations(NSString *a, NSString *b, void *context)
+{
+    NSDictionary    *durations  = (NSDictionary *)context;
+    double          durationA   = [[durations objectForKey:a] doubleValue];
+    double          durationB   = [[durations objectForKey:b] doubleValue];
+    BOOL            unknownA    = (durationA < 0.0);
+    BOOL            unknownB    = (durationB < 0.0);
+    if (unknownA != unknownB)
+        return unknownA ? NSOrderedAscending : NSOrderedDescending;
+    if (!unknownA && durationA != durationB)
+        return (durationA > durationB) ? NSOrderedAscending : NSOrderedDescending;
+    return [a compare:b];
+}
+
+- (NSArray *)classNamesSortedByDuration:(NSArray *)classNames
+{
+    NSParameterAssert(classNames != nil);
+
+    // sum per-class totals in a single pass over the timings rather than once per comparison
+    NSMutableDictionary *durations = [NSMutableDictionary dictionaryWithCapacity:[classNames count]];
+    for (NSString *className in classNames)
+        [durations setObject:[NSNumber numberWithDouble:-1.0] forKey:className];
+    @synchronized (timings)
+    {
+        for (NSString *identifier in timings)
+        {
+            NSRange separator = [identifier rangeOfString:@"/"];
+            if (separator.location == NSNotFound) continue;
+            NSString *className = [identifier substringToIndex:separator.location];
+            NSNumber *total = [durations objectForKey:className];
+            if (!total) continue;
+            double seconds = [[timings objectForKey:identifier] doubleValue] + MAX([total doubleValue], 0.0);
+            [durations setObject:[NSNumber numberWithDouble:seconds] forKey:className];
+        }
+    }
+    return [classNames sortedArrayUsingFunction:WOCompareDurations context:durations];
+}
+
+// 32-bit FNV-1a: cheap, well distributed and (unlike -hash) guaranteed to be the same on every machine and OS release; hash
+// is the value returned for the preceding part of the string (or WO_STABLE_HASH_BASIS)
+#define WO_STABLE_HASH_BASIS 2166136261U
+static uint32_t WOStableHashAppend(uint32_t hash, const char *string)
+{
+    for (const unsigned char *c = (const unsigned char *)string; *c; c++)
+    {
+        hash ^= *c;
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+static uint32_t WOStableHash(NSString *string)
+{
+    return WOStableHashAppend(WO_STABLE_HASH_BASIS, [string UTF8String]);
+}
+
+// the same as WOStableHash for the descriptor's "Class/-method" identifier, without making the identifier
+static uint32_t WOStableHashForDescriptor(const WOTestMethodDescriptor *descriptor)
+{
+    uint32_t hash = WOStableHashAppend(WO_STABLE_HASH_BASIS, class_getName(descriptor->testClass));
+    hash = WOStableHashAppend(hash, descriptor->isClassMethod ? "/+" : "/-");
+    return WOStableHashAppend(hash, sel_getName(descriptor->selector));
+}
+
+// sorts identifiers longest first, breaking ties by name so that all machines agree on the order
+static NSInteger WOCompareMethodDurations(NSString *a, NSString *b, void *context)
+{
+    NSDictionary    *durations  = (NSDictionary *)context;
+    double          durationA   = [[durations objectForKey:a] doubleValue];
+    double          durationB   = [[durations objectForKey:b] doubleValue];
+    if (durationA != durationB)
+        return (durationA > durationB) ? NSOrderedAscending : NSOrderedDescending;
+    return [a compare:b];
+}
+
+- (void)selectShard:(unsigned)index of:(unsigned)shardCount count:(unsigned)count hashes:(const uint32_t *)hashes
+        identifiers:(NSArray *)identifiers balanced:(BOOL)balanced selected:(BOOL *)selected
+{
+    BOOL *placed = calloc(count + 1, sizeof(BOOL));
+    NSAssert(placed != NULL, @"calloc() failed");
+    memset(selected, 0, count * sizeof(BOOL));
+    if (balanced)
+    {
+        NSDictionary *durations;
+        @synchronized (timings)
+        {
+            durations = [NSDictionary dictionaryWithDictionary:timings];
+        }
+        NSMutableArray      *timed      = [NSMutableArray array];
+        NSMutableDictionary *positions  = [NSMutableDictionary dictionary];
+        for (unsigned i = 0; i < count; i++)
+        {
+            NSString *identifier = [identifiers objectAtIndex:i];
+            if (![durations objectForKey:identifier]) continue;
+            [timed addObject:identifier];
+            [positions setObject:[NSNumber numberWithUnsignedInt:i] forKey:identifier];
+        }
+        [timed sortUsingFunction:WOCompareMethodDurations context:durations];
+
+        // greedy longest-processing-time-first assignment
+        double *loads = calloc(shardCount, sizeof(double));
+        NSAssert(loads != NULL, @"calloc() failed");
+        for (NSString *identifier in timed)
+        {
+            unsigned lightest = 0;
+            for (unsigned i = 1; i < shardCount; i++)
+                if (loads[i] < loads[lightest]) lightest = i;
+            loads[lightest] += [[durations objectForKey:identifier] doubleValue];
+            unsigned position = [[positions objectForKey:identifier] unsignedIntValue];
+            placed[position] = YES;
+            selected[position] = (lightest == index);
+        }
+        free(loads);
+    }
+    for (unsigned i = 0; i < count; i++)
+        if (!placed[i] && (hashes[i] % shardCount) == index) selected[i] = YES;
+    free(placed);
+}
+
+- (NSDictionary *)methodsForShard:(unsigned)index of:(unsigned)count classNames:(NSArray *)classNames balanced:(BOOL)balanced
+{
+    NSDictionary        *shard      = [self descriptorsForShard:index of:count classNames:classNames descriptors:nil
+                                                       balanced:balanced];
+    NSMutableDictionary *methods    = [NSMutableDictionary dictionaryWithCapacity:[shard count]];
+    for (NSString *className in shard)
+        [methods setObject:[self methodNamesForDescriptors:[shard objectForKey:className]] forKey:className];
+    return methods;
+}
+
+- (NSDictionary *)descriptorsForShard:(unsigned)index of:(unsigned)count classNames:(NSArray *)classNames
+                          descriptors:(NSDictionary *)classDescriptors balanced:(BOOL)balanced
+{
+    NSParameterAssert(classNames != nil);
+    NSParameterAssert(count > 0);
+    NSParameterAssert(index < count);
+
+    // gather the candidates from every class
+    NSMutableArray *candidates = [NSMutableArray arrayWithCapacity:[classNames count]];
+    unsigned total = 0;
+    for (NSString *className in classNames)
+    {
+        NSData *descriptors = nil;
+        if (classDescriptors)
+            descriptors = [classDescriptors objectForKey:className];
+        else
+        {
+            Class aClass = NSClassFromString(className);
+            descriptors = aClass ? [self testableMethodDescriptorsFrom:aClass] : nil;
+        }
+        if (!descriptors) continue;
+        [candidates addObject:[NSArray arrayWithObjects:className, descriptors, nil]];
+        total += [descriptors length] / sizeof(WOTestMethodDescriptor);
+    }
+
+    // decide which of them belong to this shard
+    uint32_t        *hashes         = malloc(sizeof(uint32_t) * (total + 1));
+    BOOL            *selected       = malloc(sizeof(BOOL) * (total + 1));
+    NSMutableArray  *identifiers    = balanced ? [NSMutableArray arrayWithCapacity:total] : nil;
+    NSAssert(hashes != NULL && selected != NULL, @"malloc() failed");
+    unsigned position = 0;
+    for (NSArray *candidate in candidates)
+    {
+        NSData                          *data           = [candidate objectAtIndex:1];
+        const WOTestMethodDescriptor    *descriptors    = [data bytes];
+        unsigned                        descriptorCount = [data length] / sizeof(WOTestMethodDescriptor);
+        for (unsigned i = 0; i < descriptorCount; i++, position++)
+        {
+            hashes[position] = WOStableHashForDescriptor(&descriptors[i]);
+            [identifiers addObject:[self identifierForDescriptor:descriptors[i]]];
+        }
+    }
+    [self selectShard:index of:count count:total hashes:hashes identifiers:identifiers balanced:balanced selected:selected];
+
+    // regroup by class, preserving the order of the methods within each class
+    NSMutableDictionary *shard = [NSMutableDictionary dictionary];
+    position = 0;
+    for (NSArray *candidate in candidates)
+    {
+        NSData                          *data           = [candidate objectAtIndex:1];
+        const WOTestMethodDescriptor    *descriptors    = [data bytes];
+        unsigned                        descriptorCount = [data length] / sizeof(WOTestMethodDescriptor);
+        NSMutableData                   *methods        = [NSMutableData data];
+        for (unsigned i = 0; i < descriptorCount; i++, position++)
+            if (selected[position]) [methods appendBytes:&descriptors[i] length:sizeof(WOTestMethodDescriptor)];
+        if ([methods length] > 0)
+            [shard setObject:methods forKey:[candidate objectAtIndex:0]];
+    }
+    free(hashes);
+    free(selected);
+    return shard;
+}
+
+- (NSDictionary *)methodsForShard:(unsigned)index of:(unsigned)count classNames:(NSArray *)classNames
+                        inventory:(NSDictionary *)classMethods balanced:(BOOL)balanced
+{
+    NSParameterAssert(classNames != nil);
+    NSParameterAssert(classMethods != nil);
+    NSParameterAssert(count > 0);
+    NSParameterAssert(index < count);
+
+    // decide which methods belong to this shard
+    NSMutableArray *identifiers = [NSMutableArray array];
+    for (NSString *className in classNames)
+        for (NSString *method in [classMethods objectForKey:className])
+            [identifiers addObject:[self identifierForMethod:method ofClassName:className]];
+    unsigned    total       = [identifiers count];
+    uint32_t    *hashes     = malloc(sizeof(uint32_t) * (total + 1));
+    BOOL        *selected   = malloc(sizeof(BOOL) * (total + 1));
+    NSAssert(hashes != NULL && selected != NULL, @"malloc() failed");
+    for (unsigned i = 0; i < total; i++)
+        hashes[i] = WOStableHash([identifiers objectAtIndex:i]);
+    [self selectShard:index of:count count:total hashes:hashes identifiers:identifiers balanced:balanced selected:selected];
+
+    // regroup by class, preserving the order of the methods within each class
+    NSMutableDictionary *shard = [NSMutableDictionary dictionary];
+    unsigned position = 0;
+    for (NSString *className in classNames)
+    {
+        NSMutableArray *methods = [NSMutableArray array];
+        for (NSString *method in [classMethods objectForKey:className])
+            if (selected[position++]) [methods addObject:method];
+        if ([methods count] > 0)
+            [shard setObject:methods forKey:className];
+    }
+    free(hashes);
+    free(selected);
+    return shard;
+}
+
+- (BOOL)loadTimingsFromFile:(NSString *)path
+{
+    NSParameterAssert(path != nil);
+    NSDictionary *loaded = [NSDictionary dictionaryWithContentsOfFile:path];
+    if (!loaded)
+        return NO;
+    @synchronized (timings)
+    {
+        for (NSString *identifier in loaded)
+        {
+            id duration = [loaded objectForKey:identifier];
+            if ([identifier isKindOfClass:[NSString class]] && [duration isKindOfClass:[NSNumber class]])
+                [timings setObject:duration forKey:identifier];
+        }
+    }
+    return YES;
+}
+
+- (BOOL)writeTimingsToFile:(NSString *)path
+{
+    NSParameterAssert(path != nil);
+    NSDictionary *snapshot;
+    @synchronized (timings)
+    {
+        snapshot = [NSDictionary dictionaryWithDictionary:timings];
+    }
+    return [snapshot writeToFile:path atomically:YES];
 }
 
 #pragma mark -
@@ -791,9 +1974,21 @@ jump_point:
     return [NSString pathWithComponents:[components subarrayWithRange:NSMakeRange(trim + 1, count - trim - 1)]];
 }
 
+- (BOOL)reportsResult:(BOOL)passed
+{
+    return (!passed || self.expectFailures || self.logsPassedTests);
+}
+
 - (void)writePassed:(BOOL)passed inFile:(char *)path atLine:(int)line message:(NSString *)message, ...
 {
-    self.testsRun++;
+    WO_INCREMENT(testsRun);
+    if (![self reportsResult:passed])
+    {
+        // quiet pass: count it without formatting the message or the path
+        [self cacheFile:path line:line];
+        WO_INCREMENT(testsPassed);
+        return;
+    }
     va_list args;
     va_start(args, message);
     NSString *string = [NSString WOTest_stringWithFormat:message arguments:args];
@@ -802,41 +1997,60 @@ jump_point:
     {
         if (passed)             // passed: bad
         {
-            [self writeErrorInFile:path atLine:line message:[NSString stringWithFormat:@"Passed (unexpected pass): %@", string]];
-            self.testsPassedUnexpected++;
+            [self writeErrorInFile:path atLine:line message:@"Passed (unexpected pass): %@", string];
+            WO_FAILURE(testsPassedUnexpected);
         }
         else                    // failed: good
         {
-            [self writeStatusInFile:path atLine:line message:[NSString stringWithFormat:@"Failed (expected failure): %@", string]];
-            self.testsFailedExpected++;
+            [self writeStatusInFile:path atLine:line message:@"Failed (expected failure): %@", string];
+            WO_INCREMENT(testsFailedExpected);
         }
     }
     else                        // normal handling (ie. passing is good, failing is bad)
     {
         if (passed)             // passed: good
         {
-            [self writeStatusInFile:path atLine:line message:[NSString stringWithFormat:@"Passed: %@", string]];
-            self.testsPassed++;
+            [self writeStatusInFile:path atLine:line message:@"Passed: %@", string];
+            WO_INCREMENT(testsPassed);
         }
         else                    // failed: bad
         {
-            [self writeErrorInFile:path atLine:line message:[NSString stringWithFormat:@"Failed: %@", string]];
-            self.testsFailed++;
+            [self writeErrorInFile:path atLine:line message:@"Failed: %@", string];
+            WO_FAILURE(testsFailed);
         }
     }
 }
 
 - (void)cacheFile:(char *)path line:(int)line
 {
-    self.lastReportedFile   = [self trimmedPath:path];
-    self.lastReportedLine   = line;
+    WOTestThreadContext *context = WO_THREAD_CONTEXT;
+    context->lastReportedPath = path;
+    context->lastReportedLine = line;
+}
+
+- (NSString *)lastReportedFile
+{
+    char *path = WO_THREAD_CONTEXT->lastReportedPath;
+    return path ? [self trimmedPath:path] : nil;
+}
+
+- (int)lastReportedLine
+{
+    return WO_THREAD_CONTEXT->lastReportedLine;
+}
+
+- (void)writeLastKnownLocation
+{
+    [self writeLastKnownLocationInContext:WO_THREAD_CONTEXT];
 }
 
-- (void)writeLastKnownLocation
+- (void)writeLastKnownLocationInContext:(WOTestThreadContext *)context
 {
-    NSString *path = self.lastReportedFile;
-    if (path)
-        _WOLog(@"%@:%d: last known location was %@:%d", path, self.lastReportedLine, path, self.lastReportedLine);
+    if (!context || !context->lastReportedPath)
+        return;
+    NSString *path = [self trimmedPath:context->lastReportedPath];
+    int line = context->lastReportedLine;
+    _WOLog(@"%@:%d: last known location was %@:%d", path, line, path, line);
 }
 
 - (void)writeErrorInFile:(char *)path atLine:(int)line message:(NSString *)message, ...
@@ -845,6 +2059,7 @@ jump_point:
     va_start(args, message);
     NSString *error = [NSString WOTest_stringWithFormat:message arguments:args];
     _WOLog(@"%@:%d: error: %@", [self trimmedPath:path], line, error);
+    _WOLogFlush(); // make sure failures are visible even if a crash follows
     [self cacheFile:path line:line];
     va_end(args);
 }
@@ -862,7 +2077,8 @@ jump_point:
 - (void)writeUncaughtException:(NSString *)info inFile:(char *)path atLine:(int)line
 {
     _WOLog(@"%@:%d: error: uncaught exception during test execution: %@", [self trimmedPath:path], line, info);
-    self.uncaughtExceptions++;
+    _WOLogFlush();
+    WO_FAILURE(uncaughtExceptions);
 }
 
 - (void)writeStatusInFile:(char *)path atLine:(int)line message:(NSString *)message, ...
@@ -899,6 +2115,7 @@ jump_point:
     va_start(args, message);
     NSString *error = [NSString WOTest_stringWithFormat:message arguments:args];
     _WOLog(@"error: %@", error); // older versions of Xcode required initial colons "::" to show this as an error
+    _WOLogFlush();
     va_end(args);
 }
 
@@ -943,9 +2160,9 @@ jump_point:
     }
     @catch (id e) {
         [self writeErrorInFile:path atLine:line message:@"uncaught exception (%@)", [NSException WOTest_descriptionForException:e]];
-        self.uncaughtExceptions++;
+        WO_FAILURE(uncaughtExceptions);
     }
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:equal];
     [self writePassed:equal inFile:path atLine:line message:@"expected %@, got %@", WO_DESC(expected), WO_DESC(actual)];
     if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
     if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
@@ -963,9 +2180,9 @@ jump_point:
     }
     @catch (id e) {
         [self writeErrorInFile:path atLine:line message:@"uncaught exception (%@)", [NSException WOTest_descriptionForException:e]];
-        self.uncaughtExceptions++;
+        WO_FAILURE(uncaughtExceptions);
     }
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:(!equal)];
     [self writePassed:(!equal) inFile:path atLine:line message:@"expected (not) %@, got %@", WO_DESC(expected), WO_DESC(actual)];
     if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
     if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
@@ -983,9 +2200,9 @@ jump_point:
     }
     @catch (id e) {
         [self writeErrorInFile:path atLine:line message:@"uncaught exception (%@)", [NSException WOTest_descriptionForException:e]];
-        self.uncaughtExceptions++;
+        WO_FAILURE(uncaughtExceptions);
     }
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:greaterThan];
     [self writePassed:greaterThan inFile:path atLine:line message:@"expected > %@, got %@", WO_DESC(expected), WO_DESC(actual)];
     if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
     if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
@@ -1003,9 +2220,9 @@ jump_point:
     }
     @catch (id e) {
         [self writeErrorInFile:path atLine:line message:@"uncaught exception (%@)", [NSException WOTest_descriptionForException:e]];
-        self.uncaughtExceptions++;
+        WO_FAILURE(uncaughtExceptions);
     }
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:notGreaterThan];
     [self writePassed:notGreaterThan inFile:path atLine:line message:@"expected <= %@, got %@", WO_DESC(expected), WO_DESC(actual)];
     if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
     if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
@@ -1023,9 +2240,9 @@ jump_point:
     }
     @catch (id e) {
         [self writeErrorInFile:path atLine:line message:@"uncaught exception (%@)", [NSException WOTest_descriptionForException:e]];
-        self.uncaughtExceptions++;
+        WO_FAILURE(uncaughtExceptions);
     }
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:lessThan];
     [self writePassed:lessThan inFile:path atLine:line message:@"expected < %@, got %@", WO_DESC(expected), WO_DESC(actual)];
     if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
     if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
@@ -1043,9 +2260,9 @@ jump_point:
     }
     @catch (id e) {
         [self writeErrorInFile:path atLine:line message:@"uncaught exception (%@)", [NSException WOTest_descriptionForException:e]];
-        self.uncaughtExceptions++;
+        WO_FAILURE(uncaughtExceptions);
     }
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:notLessThan];
     [self writePassed:notLessThan inFile:path atLine:line message:@"expected >= %@, got %@", WO_DESC(expected), WO_DESC(actual)];
     if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
     if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
@@ -1064,8 +2281,10 @@ jump_point:
 - (void)testNotNil:(void *)pointer inFile:(char *)path atLine:(int)line
 {
     BOOL result = (pointer ? YES : NO);
-    [self writePassed:result inFile:path atLine:line message:@"expected (not) nil, got %@",
-        (result ? [NSString stringWithFormat:@"%x", pointer] : @"nil")];
+    if (result)
+        [self writePassed:result inFile:path atLine:line message:@"expected (not) nil, got %x", pointer];
+    else
+        [self writePassed:result inFile:path atLine:line message:@"expected (not) nil, got nil"];
 }
 
 - (void)testPointer:(void *)actual isEqualTo:(void *)expected inFile:(char *)path atLine:(int)line
@@ -1086,7 +2305,7 @@ jump_point:
 - (void)testIsInt:(char *)type inFile:(char *)path atLine:(int)line
 {
     BOOL result = (strcmp(type, "i") == 0);
-    [self writePassed:result inFile:path atLine:line message:[NSString stringWithFormat: @"expected type \"i\", got \"%s\"", type]];
+    [self writePassed:result inFile:path atLine:line message:@"expected type \"i\", got \"%s\"", type];
 }
 
 - (void)testIsNotInt:(char *)type inFile:(char *)path atLine:(int)line
@@ -1095,7 +2314,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected type (not) \"i\", got \"%s\"", type]];
+              message:@"expected type (not) \"i\", got \"%s\"", type];
 }
 
 - (void)testIntPositive:(int)aInt inFile:(char *)path atLine:(int)line
@@ -1121,7 +2340,7 @@ jump_point:
 - (void)testInt:(int)actual isEqualTo:(int)expected inFile:(char *)path atLine:(int)line
 {
     BOOL result = (actual == expected);
-    [self writePassed:result inFile:path atLine:line message:[NSString stringWithFormat:@"expected %d, got %d", expected, actual]];
+    [self writePassed:result inFile:path atLine:line message:@"expected %d, got %d", expected, actual];
 }
 
 - (void)testInt:(int)actual isNotEqualTo:(int)expected inFile:(char *)path atLine:(int)line
@@ -1130,7 +2349,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected (not) %d, got %d", expected, actual]];
+              message:@"expected (not) %d, got %d", expected, actual];
 }
 
 - (void)testInt:(int)actual greaterThan:(int)expected inFile:(char *)path atLine:(int)line
@@ -1139,7 +2358,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected > %d, got %d", expected, actual]];
+              message:@"expected > %d, got %d", expected, actual];
 }
 
 - (void)testInt:(int)actual notGreaterThan:(int)expected inFile:(char *)path atLine:(int)line
@@ -1148,7 +2367,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected <= %d, got %d", expected, actual]];
+              message:@"expected <= %d, got %d", expected, actual];
 }
 
 - (void)testInt:(int)actual lessThan:(int)expected inFile:(char *)path atLine:(int)line
@@ -1157,7 +2376,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected < %d, got %d", expected, actual]];
+              message:@"expected < %d, got %d", expected, actual];
 }
 
 - (void)testInt:(int)actual notLessThan:(int)expected inFile:(char *)path atLine:(int)line
@@ -1166,7 +2385,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected >= %d, got %d", expected, actual]];
+              message:@"expected >= %d, got %d", expected, actual];
 }
 
 #pragma mark -
@@ -1175,7 +2394,7 @@ jump_point:
 - (void)testIsUnsigned:(char *)type inFile:(char *)path atLine:(int)line
 {
     BOOL result = (strcmp(type, "I") == 0);
-    [self writePassed:result inFile:path atLine:line message:[NSString stringWithFormat: @"expected type \"I\", got \"%s\"", type]];
+    [self writePassed:result inFile:path atLine:line message:@"expected type \"I\", got \"%s\"", type];
 }
 
 - (void)testIsNotUnsigned:(char *)type inFile:(char *)path atLine:(int)line
@@ -1184,7 +2403,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected type (not) \"I\", got \"%s\"", type]];
+              message:@"expected type (not) \"I\", got \"%s\"", type];
 }
 
 - (void)testUnsignedZero:(unsigned)aUnsigned inFile:(char *)path atLine:(int)line
@@ -1203,7 +2422,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected %u, got %u", expected, actual]];
+              message:@"expected %u, got %u", expected, actual];
 }
 
 - (void)testUnsigned:(unsigned)actual isNotEqualTo:(unsigned)expected inFile:(char *)path atLine:(int)line
@@ -1212,7 +2431,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected (not) %u, got %u", expected, actual]];
+              message:@"expected (not) %u, got %u", expected, actual];
 }
 
 - (void)testUnsigned:(unsigned)actual greaterThan:(unsigned)expected inFile:(char *)path atLine:(int)line
@@ -1221,7 +2440,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected > %u, got %u", expected, actual]];
+              message:@"expected > %u, got %u", expected, actual];
 }
 
 - (void)testUnsigned:(unsigned)actual notGreaterThan:(unsigned)expected inFile:(char *)path atLine:(int)line
@@ -1230,7 +2449,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected <= %u, got %u", expected, actual]];
+              message:@"expected <= %u, got %u", expected, actual];
 }
 
 - (void)testUnsigned:(unsigned)actual lessThan:(unsigned)expected inFile:(char *)path atLine:(int)line
@@ -1239,7 +2458,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected < %u, got %u", expected, actual]];
+              message:@"expected < %u, got %u", expected, actual];
 }
 
 - (void)testUnsigned:(unsigned)actual notLessThan:(unsigned)expected inFile:(char *)path atLine:(int)line
@@ -1248,7 +2467,121 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected >= %u, got %u", expected, actual]];
+              message:@"expected >= %u, got %u", expected, actual];
+}
+
+#pragma mark -
+#pragma mark long long test methods
+
+- (void)testLongLong:(long long)actual isEqualTo:(long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual == expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected %lld, got %lld", expected, actual];
+}
+
+- (void)testLongLong:(long long)actual isNotEqualTo:(long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual != expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected (not) %lld, got %lld", expected, actual];
+}
+
+- (void)testLongLong:(long long)actual greaterThan:(long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual > expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected > %lld, got %lld", expected, actual];
+}
+
+- (void)testLongLong:(long long)actual notGreaterThan:(long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual <= expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected <= %lld, got %lld", expected, actual];
+}
+
+- (void)testLongLong:(long long)actual lessThan:(long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual < expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected < %lld, got %lld", expected, actual];
+}
+
+- (void)testLongLong:(long long)actual notLessThan:(long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual >= expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected >= %lld, got %lld", expected, actual];
+}
+
+#pragma mark -
+#pragma mark unsigned long long test methods
+
+- (void)testUnsignedLongLong:(unsigned long long)actual isEqualTo:(unsigned long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual == expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected %llu, got %llu", expected, actual];
+}
+
+- (void)testUnsignedLongLong:(unsigned long long)actual isNotEqualTo:(unsigned long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual != expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected (not) %llu, got %llu", expected, actual];
+}
+
+- (void)testUnsignedLongLong:(unsigned long long)actual greaterThan:(unsigned long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual > expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected > %llu, got %llu", expected, actual];
+}
+
+- (void)testUnsignedLongLong:(unsigned long long)actual notGreaterThan:(unsigned long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual <= expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected <= %llu, got %llu", expected, actual];
+}
+
+- (void)testUnsignedLongLong:(unsigned long long)actual lessThan:(unsigned long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual < expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected < %llu, got %llu", expected, actual];
+}
+
+- (void)testUnsignedLongLong:(unsigned long long)actual notLessThan:(unsigned long long)expected inFile:(char *)path atLine:(int)line
+{
+    BOOL result = (actual >= expected);
+    [self writePassed:result
+               inFile:path
+               atLine:line
+              message:@"expected >= %llu, got %llu", expected, actual];
 }
 
 #pragma mark -
@@ -1257,7 +2590,7 @@ jump_point:
 - (void)testIsFloat:(char *)type inFile:(char *)path atLine:(int)line
 {
     BOOL result = (strcmp(type, "f") == 0);
-    [self writePassed:result inFile:path atLine:line message:[NSString stringWithFormat: @"expected type \"f\", got \"%s\"", type]];
+    [self writePassed:result inFile:path atLine:line message:@"expected type \"f\", got \"%s\"", type];
 }
 
 - (void)testIsNotFloat:(char *)type inFile:(char *)path atLine:(int)line
@@ -1266,7 +2599,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected type (not) \"f\", got \"%s\"", type]];
+              message:@"expected type (not) \"f\", got \"%s\"", type];
 }
 
 - (void)testFloatPositive:(float)aFloat inFile:(char *)path atLine:(int)line
@@ -1348,8 +2681,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 - (void)testFloat:(float)actual isNotEqualTo:(float)expected withinError:(float)error inFile:(char *)path atLine:(int)line
@@ -1358,8 +2690,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected (not) %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected (not) %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 - (void)testFloat:(float)actual greaterThan:(float)expected withinError:(float)error inFile:(char *)path atLine:(int)line
@@ -1368,8 +2699,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected > %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected > %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 - (void)testFloat:(float)actual notGreaterThan:(float)expected withinError:(float)error inFile:(char *)path atLine:(int)line
@@ -1378,8 +2708,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected <= %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected <= %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 - (void)testFloat:(float)actual lessThan:(float)expected withinError:(float)error inFile:(char *)path atLine:(int)line
@@ -1388,8 +2717,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected < %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected < %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 - (void)testFloat:(float)actual notLessThan:(float)expected withinError:(float)error inFile:(char *)path atLine:(int)line
@@ -1398,8 +2726,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected >= %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected >= %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 #pragma mark -
@@ -1408,7 +2735,7 @@ jump_point:
 - (void)testIsDouble:(char *)type inFile:(char *)path atLine:(int)line
 {
     BOOL result = (strcmp(type, "d") == 0);
-    [self writePassed:result inFile:path atLine:line message:[NSString stringWithFormat: @"expected type \"d\", got \"%s\"", type]];
+    [self writePassed:result inFile:path atLine:line message:@"expected type \"d\", got \"%s\"", type];
 }
 
 - (void)testIsNotDouble:(char *)type inFile:(char *)path atLine:(int)line
@@ -1417,7 +2744,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected type (not) \"d\", got \"%s\"", type]];
+              message:@"expected type (not) \"d\", got \"%s\"", type];
 }
 
 - (void)testDoublePositive:(double)aDouble inFile:(char *)path atLine:(int)line
@@ -1499,8 +2826,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 - (void)testDouble:(double)actual isNotEqualTo:(double)expected withinError:(double)error inFile:(char *)path atLine:(int)line
@@ -1509,8 +2835,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected (not) %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected (not) %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 - (void)testDouble:(double)actual greaterThan:(double)expected withinError:(double)error inFile:(char *)path atLine:(int)line
@@ -1519,8 +2844,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected > %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected > %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 - (void)testDouble:(double)actual notGreaterThan:(double)expected withinError:(double)error inFile:(char *)path atLine:(int)line
@@ -1529,8 +2853,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected <= %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected <= %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 - (void)testDouble:(double)actual lessThan:(double)expected withinError:(double)error inFile:(char *)path atLine:(int)line
@@ -1539,8 +2862,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected < %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected < %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
 }
 
 - (void)testDouble:(double)actual notLessThan:(double)expected withinError:(float)error inFile:(char *)path atLine:(int)line
@@ -1549,19 +2871,155 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected >= %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual]];
+              message:@"expected >= %f (%C%f), got %f", expected, WO_UNICODE_PLUS_MINUS_SIGN, error, actual];
+}
+
+#pragma mark -
+#pragma mark float and double array test methods
+
+// elements are checked a block at a time: a branch-free pass over the block (which the compiler can vectorize) counts the
+// elements that are exactly equal or within the absolute or relative tolerance and finds the largest error; only blocks
+// with elements that fail that test, or which contain a new worst error, are looked at again one element at a time
+#define WO_ARRAY_BLOCK_SIZE         256
+
+typedef struct WOArrayComparison {
+    size_t              mismatches;     // elements outside all of the tolerances
+    size_t              worstIndex;     // index of the element with the largest absolute error
+    double              worstError;     // largest absolute error (NaN if an element is NaN where the other is not)
+    unsigned long long  worstUlps;      // distance in units in the last place between the elements at worstIndex
+} WOArrayComparison;
+
+// maps the bits of a floating-point value onto unsigned integers which are ordered the same way as the values, so that the
+// difference between two of them is their distance in units in the last place (ULPs)
+#define WO_ORDERED_BITS(bits, signBit)  (((bits) & (signBit)) ? ~(bits) : ((bits) | (signBit)))
+
+#define WO_DEFINE_ARRAY_COMPARISON(name, type, bitsType, signBit, absoluteValue, maxValue)                                  \
+static unsigned long long name ## Ulps(type a, type b)                                                                      \
+{                                                                                                                           \
+    union { type value; bitsType bits; } x = { a }, y = { b };                                                              \
+    bitsType orderedX = WO_ORDERED_BITS(x.bits, signBit), orderedY = WO_ORDERED_BITS(y.bits, signBit);                      \
+    return (unsigned long long)((orderedX > orderedY) ? (orderedX - orderedY) : (orderedY - orderedX));                     \
+}                                                                                                                           \
+                                                                                                                            \
+static WOArrayComparison name(const type *actual, const type *expected, size_t count, type absoluteError,                  \
+                              type relativeError, unsigned ulps)                                                            \
+{                                                                                                                           \
+    WOArrayComparison result = { 0, 0, 0.0, 0 };                                                                            \
+    type worst = 0;                                                                                                         \
+    BOOL sawNaN = NO;                                                                                                       \
+    for (size_t start = 0; start < count; start += WO_ARRAY_BLOCK_SIZE)                                                     \
+    {                                                                                                                       \
+        size_t end = MIN(count, start + WO_ARRAY_BLOCK_SIZE);                                                               \
+        size_t within = 0;                                                                                                  \
+        type blockWorst = 0;                                                                                                \
+        for (size_t i = start; i < end; i++)                                                                                \
+        {                                                                                                                   \
+            type a = actual[i], e = expected[i];                                                                            \
+            type difference = absoluteValue(a - e);                                                                         \
+            type scale = MAX(absoluteValue(a), absoluteValue(e));                                                           \
+            BOOL finite = (absoluteValue(a) <= maxValue) & (absoluteValue(e) <= maxValue);  /* false for NaN too */         \
+            within += ((a == e) | (finite & ((difference <= absoluteError) | (difference <= relativeError * scale))));     \
+            blockWorst = (difference > blockWorst) ? difference : blockWorst;                                               \
+        }                                                                                                                   \
+        if (within == end - start && !(blockWorst > worst))                                                                 \
+            continue;                                                                                                       \
+        for (size_t i = start; i < end; i++)                                                                                \
+        {                                                                                                                   \
+            type a = actual[i], e = expected[i];                                                                            \
+            type difference = absoluteValue(a - e);                                                                         \
+            BOOL isNaN = (a != a) || (e != e);                                                                              \
+            BOOL finite = (absoluteValue(a) <= maxValue) && (absoluteValue(e) <= maxValue);                                 \
+            unsigned long long distance = name ## Ulps(a, e);                                                               \
+            if ((a == e) || ((a != a) && (e != e)))                                                                         \
+                continue;                                                                                                   \
+            /* infinities only match themselves: inf - x is inf, which any tolerance scaled by inf would let through */     \
+            if (!finite || !((difference <= absoluteError) ||                                                               \
+                           (difference <= relativeError * MAX(absoluteValue(a), absoluteValue(e))) ||                       \
+                           (distance <= ulps)))                                                                             \
+                result.mismatches++;                                                                                        \
+            if (sawNaN)                                                                                                     \
+                continue;   /* the first lone NaN stays the worst error */                                                  \
+            if (isNaN || difference > worst)                                                                                \
+            {                                                                                                               \
+                worst               = difference;                                                                           \
+                sawNaN              = isNaN;                                                                                \
+                result.worstIndex   = i;                                                                                    \
+                result.worstError   = (double)difference;                                                                   \
+                result.worstUlps    = distance;                                                                             \
+            }                                                                                                               \
+        }                                                                                                                   \
+    }                                                                                                                       \
+    return result;                                                                                                          \
+}
+
+WO_DEFINE_ARRAY_COMPARISON(WOCompareFloatArrays, float, uint32_t, 0x80000000U, fabsf, FLT_MAX)
+WO_DEFINE_ARRAY_COMPARISON(WOCompareDoubleArrays, double, uint64_t, 0x8000000000000000ULL, fabs, DBL_MAX)
+
+- (void)testFloats:(const float *)actual areEqualTo:(const float *)expected count:(size_t)count
+     absoluteError:(float)absoluteError relativeError:(float)relativeError ulps:(unsigned)ulps
+            inFile:(char *)path atLine:(int)line
+{
+    if (count > 0 && (!actual || !expected))
+        [NSException WOTest_raise:WO_TEST_NIL_PARAMETER_EXCEPTION
+                           reason:WO_NIL_PARAMETER_EXCEPTION_REASON
+                           inFile:path
+                           atLine:line];
+    WOArrayComparison result = WOCompareFloatArrays(actual, expected, count, absoluteError, relativeError, ulps);
+    [self writePassed:(result.mismatches == 0)
+               inFile:path
+               atLine:line
+              message:@"expected %lu floats within %C%g (or %C%g relative, or %u ulps), got %lu outside; "
+                      @"worst error %g (%llu ulps) at index %lu: expected %g, got %g",
+        (unsigned long)count, WO_UNICODE_PLUS_MINUS_SIGN, absoluteError, WO_UNICODE_PLUS_MINUS_SIGN, relativeError, ulps,
+        (unsigned long)result.mismatches, result.worstError, result.worstUlps, (unsigned long)result.worstIndex,
+        count ? expected[result.worstIndex] : 0.0f, count ? actual[result.worstIndex] : 0.0f];
+}
+
+- (void)testDoubles:(const double *)actual areEqualTo:(const double *)expected count:(size_t)count
+      absoluteError:(double)absoluteError relativeError:(double)relativeError ulps:(unsigned)ulps
+             inFile:(char *)path atLine:(int)line
+{
+    if (count > 0 && (!actual || !expected))
+        [NSException WOTest_raise:WO_TEST_NIL_PARAMETER_EXCEPTION
+                           reason:WO_NIL_PARAMETER_EXCEPTION_REASON
+                           inFile:path
+                           atLine:line];
+    WOArrayComparison result = WOCompareDoubleArrays(actual, expected, count, absoluteError, relativeError, ulps);
+    [self writePassed:(result.mismatches == 0)
+               inFile:path
+               atLine:line
+              message:@"expected %lu doubles within %C%g (or %C%g relative, or %u ulps), got %lu outside; "
+                      @"worst error %g (%llu ulps) at index %lu: expected %g, got %g",
+        (unsigned long)count, WO_UNICODE_PLUS_MINUS_SIGN, absoluteError, WO_UNICODE_PLUS_MINUS_SIGN, relativeError, ulps,
+        (unsigned long)result.mismatches, result.worstError, result.worstUlps, (unsigned long)result.worstIndex,
+        count ? expected[result.worstIndex] : 0.0, count ? actual[result.worstIndex] : 0.0];
 }
 
 #pragma mark -
 #pragma mark object test methods
 
+// identical pointers (including two nils) are always equal, without sending isEqual:; otherwise isEqual: is only sent if the
+// object implements it (WOLightweightRoot instances and mocks may not), and an exception from it counts as "not equal"
+static BOOL WOObjectsEqual(id actual, id expected)
+{
+    if (actual == expected)
+        return YES;
+    @try
+    {
+        if (actual && expected && [NSObject WOTest_object:actual respondsToSelector:@selector(isEqual:)])
+            return [actual isEqual:expected];
+    }
+    @catch (id e)
+    {
+        // fall through
+    }
+    return NO;
+}
+
 - (void)testObject:(id)actual isEqualTo:(id)expected inFile:(char *)path atLine:(int)line
 {
-    BOOL equal = NO;
-    if (!actual && !expected) equal = YES; // equal (both nil)
-    else if (actual) equal = [actual isEqual:expected];
-    BOOL expectedTruncated, actualTruncated;
+    BOOL equal = WOObjectsEqual(actual, expected);
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:equal];
     [self writePassed:equal inFile:path atLine:line message:@"expected \"%@\", got \"%@\"", WO_DESC(expected), WO_DESC(actual)];
     if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
     if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
@@ -1569,10 +3027,8 @@ jump_point:
 
 - (void)testObject:(id)actual isNotEqualTo:(id)expected inFile:(char *)path atLine:(int)line
 {
-    BOOL equal = NO;
-    if (!actual && !expected) equal = YES; // equal (both nil)
-    else if (actual) equal = [actual isEqual:expected];
-    BOOL expectedTruncated, actualTruncated;
+    BOOL equal = WOObjectsEqual(actual, expected);
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:(!equal)];
     [self writePassed:(!equal)
                inFile:path
                atLine:line
@@ -1599,10 +3055,10 @@ jump_point:
     BOOL equal = NO;
     if (!actual && !expected) equal = YES; // equal (both nil)
     else if (actual) equal = [actual isEqualToString:expected];
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:equal];
     [self writePassed:equal inFile:path atLine:line message:@"expected \"%@\", got \"%@\"", WO_DESC(expected), WO_DESC(actual)];
-    if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
-    if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
+    if (!equal && actual && expected)
+        [self writeDifferencesFromString:expected toString:actual];
 }
 
 - (void)testString:(NSString *)actual isNotEqualTo:(NSString *)expected inFile:(char *)path atLine:(int)line
@@ -1620,7 +3076,7 @@ jump_point:
     BOOL equal = NO;
     if (!actual && !expected) equal = YES; // equal (both nil)
     else if (actual) equal = [actual isEqualToString:expected];
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:equal];
     [self writePassed:equal
                inFile:path
                atLine:line
@@ -1646,14 +3102,14 @@ jump_point:
                            reason:WO_EXPECTED_STRING_EXCEPTION_REASON(expected)
                            inFile:path
                            atLine:line];
-    BOOL result = actual ? NO : [actual hasPrefix:expected];
-    BOOL expectedTruncated, actualTruncated;
+    BOOL result = actual ? [actual hasPrefix:expected] : NO;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:result];
     [self writePassed:result
                inFile:path
                atLine:line
               message:@"expected prefix \"%@\", got \"%@\"", WO_DESC(expected), WO_DESC(actual)];
-    if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
-    if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
+    if (!result && actual)
+        [self writeDifferencesFromString:expected toString:actual]; // reports the first mismatch within the prefix
 }
 
 - (void)testString:(NSString *)actual doesNotHavePrefix:(NSString *)expected inFile:(char *)path atLine:(int)line
@@ -1674,7 +3130,7 @@ jump_point:
                            inFile:path
                            atLine:line];
     BOOL result = actual ? (![actual hasPrefix:expected]) : NO;
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:result];
     [self writePassed:result
                inFile:path
                atLine:line
@@ -1700,8 +3156,8 @@ jump_point:
                            reason:WO_EXPECTED_STRING_EXCEPTION_REASON(expected)
                            inFile:path
                            atLine:line];
-    BOOL result = actual ? NO : [actual hasSuffix:expected];
-    BOOL expectedTruncated, actualTruncated;
+    BOOL result = actual ? [actual hasSuffix:expected] : NO;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:result];
     [self writePassed:result
                inFile:path
                atLine:line
@@ -1728,7 +3184,7 @@ jump_point:
                            inFile:path
                            atLine:line];
     BOOL result = actual ? (![actual hasSuffix:expected]) : NO;
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:result];
     [self writePassed:result
                inFile:path
                atLine:line
@@ -1754,8 +3210,8 @@ jump_point:
                            reason:WO_EXPECTED_STRING_EXCEPTION_REASON(expected)
                            inFile:path
                            atLine:line];
-    BOOL result = actual ? NO : (!NSEqualRanges([actual rangeOfString:expected], NSMakeRange(NSNotFound, 0)));
-    BOOL expectedTruncated, actualTruncated;
+    BOOL result = actual ? (!NSEqualRanges([actual rangeOfString:expected], NSMakeRange(NSNotFound, 0))) : NO;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:result];
     [self writePassed:result
                inFile:path
                atLine:line
@@ -1781,8 +3237,8 @@ jump_point:
                            reason:WO_EXPECTED_STRING_EXCEPTION_REASON(expected)
                            inFile:path
                            atLine:line];
-    BOOL result = actual ? YES : (NSEqualRanges([actual rangeOfString:expected], NSMakeRange(NSNotFound, 0)));
-    BOOL expectedTruncated, actualTruncated;
+    BOOL result = actual ? (NSEqualRanges([actual rangeOfString:expected], NSMakeRange(NSNotFound, 0))) : YES;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:result];
     [self writePassed:result
                inFile:path
                atLine:line
@@ -1791,6 +3247,328 @@ jump_point:
     if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
 }
 
+#pragma mark -
+#pragma mark String differences
+
+// characters compared per getCharacters:range: call when looking for the first difference
+#define WO_STRING_BLOCK_SIZE        256
+
+// characters shown either side of the first difference
+#define WO_STRING_DIFF_CONTEXT      32
+
+// maximum number of lines compared (starting with the one containing the first difference)
+#define WO_STRING_DIFF_LINES        5
+
+typedef struct WOStringMismatch {
+    NSUInteger  index;      // index of the first differing character (the length of the shorter string if one is a prefix)
+    NSUInteger  line;       // 1-based line and column of that character
+    NSUInteger  column;
+    NSUInteger  lineStart;  // index of the first character of that line
+} WOStringMismatch;
+
+// finds the first difference between \p a and \p b, counting newlines along the way so that locating the line costs nothing extra
+static WOStringMismatch WOFirstStringMismatch(NSString *a, NSString *b)
+{
+    unichar             aBuffer[WO_STRING_BLOCK_SIZE], bBuffer[WO_STRING_BLOCK_SIZE];
+    NSUInteger          length      = MIN([a length], [b length]);
+    WOStringMismatch    mismatch    = { length, 1, 1, 0 };
+    for (NSUInteger offset = 0; offset < length; offset += WO_STRING_BLOCK_SIZE)
+    {
+        NSRange block = NSMakeRange(offset, MIN(length - offset, (NSUInteger)WO_STRING_BLOCK_SIZE));
+        [a getCharacters:aBuffer range:block];
+        [b getCharacters:bBuffer range:block];
+        for (NSUInteger i = 0; i < block.length; i++)
+        {
+            if (aBuffer[i] != bBuffer[i])
+            {
+                mismatch.index = offset + i;
+                mismatch.column = mismatch.index - mismatch.lineStart + 1;
+                return mismatch;
+            }
+            if (aBuffer[i] == '\n')
+            {
+                mismatch.line++;
+                mismatch.lineStart = offset + i + 1;
+            }
+        }
+    }
+    mismatch.column = length - mismatch.lineStart + 1;
+    return mismatch;
+}
+
+// characters of \p string in \p range with newlines, tabs and quotes escaped so that the excerpt fits on one line
+static NSString *WOEscapedExcerpt(NSString *string, NSRange range)
+{
+    unichar         buffer[2 * WO_STRING_DIFF_CONTEXT + 1];
+    NSMutableString *excerpt = [NSMutableString stringWithCapacity:range.length + 2];
+    range.length = MIN(range.length, (NSUInteger)(sizeof(buffer) / sizeof(unichar)));
+    [string getCharacters:buffer range:range];
+    for (NSUInteger i = 0; i < range.length; i++)
+    {
+        switch (buffer[i])
+        {
+            case '\n':  [excerpt appendString:@"\\n"];   break;
+            case '\r':  [excerpt appendString:@"\\r"];   break;
+            case '\t':  [excerpt appendString:@"\\t"];   break;
+            case '"':   [excerpt appendString:@"\\\""];  break;
+            case '\\':  [excerpt appendString:@"\\\\"];  break;
+            default:    [excerpt appendFormat:@"%C", buffer[i]];
+        }
+    }
+    return excerpt;
+}
+
+// the text around \p index, marked with ellipses where it has been cut from a longer string
+static NSString *WOContextExcerpt(NSString *string, NSUInteger index)
+{
+    NSUInteger length   = [string length];
+    NSUInteger start    = (index > WO_STRING_DIFF_CONTEXT) ? index - WO_STRING_DIFF_CONTEXT : 0;
+    NSUInteger end      = MIN(length, index + WO_STRING_DIFF_CONTEXT);
+    NSString *before    = (start > 0) ? [NSString WOTest_stringWithCharacter:WO_UNICODE_ELLIPSIS] : @"";
+    NSString *after     = (end < length) ? [NSString WOTest_stringWithCharacter:WO_UNICODE_ELLIPSIS] : @"";
+    return [NSString stringWithFormat:@"%@\"%@\"%@", before, WOEscapedExcerpt(string, NSMakeRange(start, end - start)), after];
+}
+
+// the line of \p string starting at \p *start, cut at WO_TRUNCATE_INDEX characters; advances \p *start to the next line, or to
+// NSNotFound if there are no more lines or the line was too long to find its end without scanning further
+static NSString *WONextLine(NSString *string, NSUInteger *start)
+{
+    NSUInteger length = [string length];
+    if (*start == NSNotFound || *start >= length)
+    {
+        *start = NSNotFound;
+        return nil;
+    }
+    NSRange search  = NSMakeRange(*start, MIN(length - *start, (NSUInteger)WO_TRUNCATE_INDEX + 1));
+    NSRange newline = [string rangeOfString:@"\n" options:NSLiteralSearch range:search];
+    NSString *text;
+    if (newline.location != NSNotFound)
+    {
+        text = WOEscapedExcerpt(string, NSMakeRange(*start, newline.location - *start));
+        *start = newline.location + 1;
+    }
+    else if (NSMaxRange(search) == length)
+    {
+        text = WOEscapedExcerpt(string, search);
+        *start = NSNotFound;
+    }
+    else
+    {
+        text = [WOEscapedExcerpt(string, NSMakeRange(*start, WO_TRUNCATE_INDEX)) WOTest_stringByAppendingCharacter:WO_UNICODE_ELLIPSIS];
+        *start = NSNotFound;
+    }
+    return text;
+}
+
+- (void)writeDifferencesFromString:(NSString *)expected toString:(NSString *)actual
+{
+    NSParameterAssert(expected != nil);
+    NSParameterAssert(actual != nil);
+    WOStringMismatch mismatch = WOFirstStringMismatch(expected, actual);
+    _WOLog(@"strings first differ at index %lu (line %lu, column %lu); expected length %lu, got %lu",
+           (unsigned long)mismatch.index, (unsigned long)mismatch.line, (unsigned long)mismatch.column,
+           (unsigned long)[expected length], (unsigned long)[actual length]);
+    _WOLog(@"  expected: %@", WOContextExcerpt(expected, mismatch.index));
+    _WOLog(@"  actual:   %@", WOContextExcerpt(actual, mismatch.index));
+
+    // both strings are identical up to the mismatch, so their lines from there on can be compared pairwise
+    _WOLog(@"  lines from %lu (\"-\" expected, \"+\" actual):", (unsigned long)mismatch.line);
+    NSUInteger expectedStart = mismatch.lineStart, actualStart = mismatch.lineStart;
+    for (unsigned i = 0; i < WO_STRING_DIFF_LINES; i++)
+    {
+        if (expectedStart == NSNotFound && actualStart == NSNotFound)
+            return;
+        NSString *expectedLine  = WONextLine(expected, &expectedStart);
+        NSString *actualLine    = WONextLine(actual, &actualStart);
+        if (expectedLine && actualLine && [expectedLine isEqualToString:actualLine])
+            _WOLog(@"    %@", expectedLine);
+        else
+        {
+            if (expectedLine)   _WOLog(@"  - %@", expectedLine);
+            if (actualLine)     _WOLog(@"  + %@", actualLine);
+        }
+    }
+    if (expectedStart != NSNotFound || actualStart != NSNotFound)
+        _WOLog(@"  ... (remaining lines not compared)");
+}
+
+#pragma mark -
+#pragma mark Collection differences
+
+// maximum number of differences listed when two collections don't match
+#define WO_DIFF_LIMIT               10
+
+// edit distance beyond which the Myers diff gives up and elements are compared by position instead; keeps the diff linear in
+// the length of the arrays (and its trace below 300 KB) however different they are
+#define WO_DIFF_MAX_EDIT_DISTANCE   128
+
+typedef struct WODiffEdit {
+    BOOL        insertion;      // YES: element only in the actual array; NO: element only in the expected array
+    NSUInteger  index;          // index of the element in whichever array it belongs to
+} WODiffEdit;
+
+// Myers' O((N+M)D) diff of expected[start, expectedEnd) against actual[start, actualEnd): writes the edit script (in order)
+// into \p edits, which must have room for WO_DIFF_MAX_EDIT_DISTANCE entries, and returns the number of edits, or NSNotFound if
+// more than WO_DIFF_MAX_EDIT_DISTANCE edits would be needed
+static NSUInteger WODiffArrays(NSArray *expected, NSArray *actual, NSUInteger start, NSUInteger expectedEnd,
+                               NSUInteger actualEnd, WODiffEdit *edits)
+{
+    NSInteger n = expectedEnd - start, m = actualEnd - start;
+    NSInteger max = MIN(n + m, WO_DIFF_MAX_EDIT_DISTANCE);
+    NSInteger width = 2 * max + 2;                                          // one spare so round 0 can read v[1 + max]
+    NSInteger *v = calloc(width, sizeof(NSInteger));                       // furthest x reached on each diagonal k (at v[k + max])
+    NSInteger *trace = malloc((max + 1) * width * sizeof(NSInteger));      // v as it stood at the start of each round
+    NSCAssert(v && trace, @"memory allocation failed");
+    NSInteger d, found = -1;
+    for (d = 0; d <= max && found < 0; d++)
+    {
+        memcpy(trace + d * width, v, width * sizeof(NSInteger));
+        for (NSInteger k = -d; k <= d; k += 2)
+        {
+            NSInteger x;
+            if (k == -d || (k != d && v[k - 1 + max] < v[k + 1 + max]))
+                x = v[k + 1 + max];                                         // step down (insertion)
+            else
+                x = v[k - 1 + max] + 1;                                     // step right (deletion)
+            NSInteger y = x - k;
+            while (x < n && y < m &&
+                   [[expected objectAtIndex:start + x] isEqual:[actual objectAtIndex:start + y]])
+                x++, y++;
+            v[k + max] = x;
+            if (x >= n && y >= m)
+            {
+                found = d;
+                break;
+            }
+        }
+    }
+    if (found < 0)
+    {
+        free(v);
+        free(trace);
+        return NSNotFound;
+    }
+
+    // walk back through the trace, filling the edit script in from the end
+    NSInteger x = n, y = m;
+    for (d = found; d > 0; d--)
+    {
+        NSInteger *previous = trace + d * width;
+        NSInteger k = x - y, previousK;
+        if (k == -d || (k != d && previous[k - 1 + max] < previous[k + 1 + max]))
+            previousK = k + 1;
+        else
+            previousK = k - 1;
+        NSInteger previousX = previous[previousK + max], previousY = previousX - previousK;
+        WODiffEdit *edit = edits + d - 1;
+        edit->insertion = (previousK == k + 1);
+        edit->index     = start + (edit->insertion ? previousY : previousX);
+        x = previousX;
+        y = previousY;
+    }
+    free(v);
+    free(trace);
+    return (NSUInteger)found;
+}
+
+- (void)writeDifferencesFromArray:(NSArray *)expected toArray:(NSArray *)actual
+{
+    NSParameterAssert(expected != nil);
+    NSParameterAssert(actual != nil);
+    NSUInteger expectedCount = [expected count], actualCount = [actual count];
+
+    // common prefix and suffix are skipped in linear time before any diffing
+    NSUInteger start = 0, expectedEnd = expectedCount, actualEnd = actualCount;
+    while (start < expectedEnd && start < actualEnd && [[expected objectAtIndex:start] isEqual:[actual objectAtIndex:start]])
+        start++;
+    while (expectedEnd > start && actualEnd > start &&
+           [[expected objectAtIndex:expectedEnd - 1] isEqual:[actual objectAtIndex:actualEnd - 1]])
+        expectedEnd--, actualEnd--;
+
+    WODiffEdit  *edits  = malloc(WO_DIFF_MAX_EDIT_DISTANCE * sizeof(WODiffEdit));
+    NSCAssert(edits != NULL, @"malloc() failed");
+    NSUInteger  count   = WODiffArrays(expected, actual, start, expectedEnd, actualEnd, edits);
+    if (count != NSNotFound)
+    {
+        _WOLog(@"arrays differ by %lu edit%@ (expected %lu elements, got %lu); \"-\" marks elements only in the expected "
+               @"array and \"+\" those only in the actual array:", (unsigned long)count, (count == 1) ? @"" : @"s",
+               (unsigned long)expectedCount, (unsigned long)actualCount);
+        for (NSUInteger i = 0; i < MIN(count, (NSUInteger)WO_DIFF_LIMIT); i++)
+        {
+            id object = [(edits[i].insertion ? actual : expected) objectAtIndex:edits[i].index];
+            _WOLog(@"  %C [%lu] %@", (unichar)(edits[i].insertion ? '+' : '-'), (unsigned long)edits[i].index,
+                   [self description:object truncatedAt:WO_TRUNCATE_INDEX didTruncate:NULL]);
+        }
+        if (count > WO_DIFF_LIMIT)
+            _WOLog(@"  ... and %lu more", (unsigned long)(count - WO_DIFF_LIMIT));
+    }
+    else
+    {
+        // too different for a minimal diff to help: compare what's left by position
+        _WOLog(@"arrays differ by more than %d edits (expected %lu elements, got %lu); first differences by position:",
+               WO_DIFF_MAX_EDIT_DISTANCE, (unsigned long)expectedCount, (unsigned long)actualCount);
+        NSUInteger shown = 0;
+        for (NSUInteger i = start; i < MAX(expectedEnd, actualEnd) && shown < WO_DIFF_LIMIT; i++)
+        {
+            id expectedObject   = (i < expectedEnd) ? [expected objectAtIndex:i] : nil;
+            id actualObject     = (i < actualEnd) ? [actual objectAtIndex:i] : nil;
+            if (expectedObject && actualObject && [expectedObject isEqual:actualObject])
+                continue;
+            _WOLog(@"  [%lu] expected %@, got %@", (unsigned long)i,
+                   [self description:expectedObject truncatedAt:WO_TRUNCATE_INDEX didTruncate:NULL],
+                   [self description:actualObject truncatedAt:WO_TRUNCATE_INDEX didTruncate:NULL]);
+            shown++;
+        }
+    }
+    free(edits);
+}
+
+- (void)writeDifferencesFromDictionary:(NSDictionary *)expected toDictionary:(NSDictionary *)actual
+{
+    NSParameterAssert(expected != nil);
+    NSParameterAssert(actual != nil);
+    NSMutableArray  *lines      = [NSMutableArray arrayWithCapacity:WO_DIFF_LIMIT];
+    NSUInteger      missing     = 0, unexpected = 0, changed = 0;
+    for (id key in expected)
+    {
+        id expectedObject   = [expected objectForKey:key];
+        id actualObject     = [actual objectForKey:key];
+        if (actualObject && [actualObject isEqual:expectedObject])
+            continue;
+        if (actualObject)
+            changed++;
+        else
+            missing++;
+        if ([lines count] < WO_DIFF_LIMIT)
+        {
+            NSString *keyDescription = [self description:key truncatedAt:WO_TRUNCATE_INDEX didTruncate:NULL];
+            NSString *expectedDescription = [self description:expectedObject truncatedAt:WO_TRUNCATE_INDEX didTruncate:NULL];
+            if (actualObject)
+                [lines addObject:[NSString stringWithFormat:@"  ~ %@: expected %@, got %@", keyDescription, expectedDescription,
+                    [self description:actualObject truncatedAt:WO_TRUNCATE_INDEX didTruncate:NULL]]];
+            else
+                [lines addObject:[NSString stringWithFormat:@"  - %@: %@", keyDescription, expectedDescription]];
+        }
+    }
+    for (id key in actual)
+    {
+        if ([expected objectForKey:key])
+            continue;
+        unexpected++;
+        if ([lines count] < WO_DIFF_LIMIT)
+            [lines addObject:[NSString stringWithFormat:@"  + %@: %@",
+                [self description:key truncatedAt:WO_TRUNCATE_INDEX didTruncate:NULL],
+                [self description:[actual objectForKey:key] truncatedAt:WO_TRUNCATE_INDEX didTruncate:NULL]]];
+    }
+    _WOLog(@"dictionaries differ: %lu key%@ missing (-), %lu unexpected (+), %lu with different values (~):",
+           (unsigned long)missing, (missing == 1) ? @"" : @"s", (unsigned long)unexpected, (unsigned long)changed);
+    for (NSString *diffLine in lines)
+        _WOLog(@"%@", diffLine);
+    NSUInteger total = missing + unexpected + changed;
+    if (total > [lines count])
+        _WOLog(@"  ... and %lu more", (unsigned long)(total - [lines count]));
+}
+
 #pragma mark -
 #pragma mark NSArray test methods
 
@@ -1809,10 +3587,10 @@ jump_point:
     BOOL equal = NO;
     if (!actual && !expected) equal = YES; // equal (both nil)
     else if (actual) equal = [actual isEqualToArray:expected];
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:equal];
     [self writePassed:equal inFile:path atLine:line message:@"expected %@, got %@", WO_DESC(expected), WO_DESC(actual)];
-    if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
-    if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
+    if (!equal && actual && expected)
+        [self writeDifferencesFromArray:expected toArray:actual];   // full descriptions of large arrays are no help
 }
 
 - (void)testArray:(NSArray *)actual isNotEqualTo:(NSArray *)expected inFile:(char *)path atLine:(int)line
@@ -1830,7 +3608,7 @@ jump_point:
     BOOL equal = NO;
     if (!actual && !expected) equal = YES; // equal (both nil)
     else if (actual) equal = [actual isEqualToArray:expected];
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:(!equal)];
     [self writePassed:(!equal) inFile:path atLine:line message:@"expected (not) %@, got %@", WO_DESC(expected), WO_DESC(actual)];
     if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
     if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
@@ -1841,12 +3619,12 @@ jump_point:
 
 - (void)testDictionary:(NSDictionary *)actual isEqualTo:(NSDictionary *)expected inFile:(char *)path atLine:(int)line
 {
-    if (actual && ![actual isKindOfClass:[NSArray class]])
+    if (actual && ![actual isKindOfClass:[NSDictionary class]])
         [NSException WOTest_raise:WO_TEST_CLASS_MISMATCH_EXCEPTION
                             reason:WO_EXPECTED_DICTIONARY_EXCEPTION_REASON(actual)
                             inFile:path
                             atLine:line];
-    if (expected && ![expected isKindOfClass:[NSArray class]])
+    if (expected && ![expected isKindOfClass:[NSDictionary class]])
         [NSException WOTest_raise:WO_TEST_CLASS_MISMATCH_EXCEPTION
                             reason:WO_EXPECTED_DICTIONARY_EXCEPTION_REASON(expected)
                             inFile:path
@@ -1854,10 +3632,10 @@ jump_point:
     BOOL equal = NO;
     if (!actual && !expected) equal = YES; // equal (both nil)
     else if (actual) equal = [actual isEqualToDictionary:expected];
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:equal];
     [self writePassed:equal inFile:path atLine:line message:@"expected %@, got %@", WO_DESC(expected), WO_DESC(actual)];
-    if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
-    if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
+    if (!equal && actual && expected)
+        [self writeDifferencesFromDictionary:expected toDictionary:actual];
 }
 
 - (void)testDictionary:(NSDictionary *)actual isNotEqualTo:(NSDictionary *)expected inFile:(char *)path atLine:(int)line
@@ -1875,12 +3653,105 @@ jump_point:
     BOOL equal = NO;
     if (!actual && !expected) equal = YES; // equal (both nil)
     else if (actual) equal = [actual isEqualToDictionary:expected];
-    BOOL expectedTruncated, actualTruncated;
+    BOOL expectedTruncated = NO, actualTruncated = NO, reported = [self reportsResult:(!equal)];
     [self writePassed:(!equal) inFile:path atLine:line message:@"expected (not) %@, got %@", WO_DESC(expected), WO_DESC(actual)];
     if (expectedTruncated)  _WOLog(@"expected result (not truncated): %@", WO_LONG_DESC(expected));
     if (actualTruncated)    _WOLog(@"actual result (not truncated): %@", WO_LONG_DESC(actual));
 }
 
+#pragma mark -
+#pragma mark Buffer and NSData test methods
+
+// buffers are compared a block at a time with memcmp(), which libSystem vectorizes; only the block containing the first
+// difference is then scanned byte by byte
+#define WO_MISMATCH_BLOCK_SIZE      256
+
+// number of bytes shown on either side of the first difference when two buffers don't match
+#define WO_HEX_WINDOW               8
+
+// returns the offset of the first byte at which \p a and \p b differ, or \p length if the first \p length bytes are identical
+static size_t WOFirstMismatch(const unsigned char *a, const unsigned char *b, size_t length)
+{
+    size_t offset = 0;
+    while (offset < length)
+    {
+        size_t block = MIN(length - offset, (size_t)WO_MISMATCH_BLOCK_SIZE);
+        if (memcmp(a + offset, b + offset, block) != 0)
+        {
+            while (a[offset] == b[offset])
+                offset++;
+            return offset;
+        }
+        offset += block;
+    }
+    return length;
+}
+
+// hex dump of the bytes around \p offset, with the byte at \p offset (if any) in brackets; for example "0x0c: 0a 0b [0c] 0d"
+static NSString *WOHexWindow(const unsigned char *bytes, size_t length, size_t offset)
+{
+    size_t start    = (offset > WO_HEX_WINDOW) ? offset - WO_HEX_WINDOW : 0;
+    size_t end      = MIN(length, offset + WO_HEX_WINDOW + 1);
+    NSMutableString *window = [NSMutableString stringWithFormat:@"0x%lx:", (unsigned long)start];
+    for (size_t i = start; i < end; i++)
+        [window appendFormat:(i == offset) ? @" [%02x]" : @" %02x", bytes[i]];
+    if (offset >= length)
+        [window appendString:@" [end]"];
+    return window;
+}
+
+- (void)testBuffer:(const void *)actual isEqualTo:(const void *)expected length:(size_t)length inFile:(char *)path atLine:(int)line
+{
+    if (length > 0 && (!actual || !expected))
+        [NSException WOTest_raise:WO_TEST_NIL_PARAMETER_EXCEPTION
+                           reason:WO_NIL_PARAMETER_EXCEPTION_REASON
+                           inFile:path
+                           atLine:line];
+    size_t mismatch = (actual == expected) ? length : WOFirstMismatch(actual, expected, length);
+    BOOL equal = (mismatch == length);
+    [self writePassed:equal inFile:path atLine:line message:@"expected %lu identical bytes, first difference at offset %lu",
+        (unsigned long)length, (unsigned long)mismatch];
+    if (!equal)
+    {
+        _WOLog(@"expected: %@", WOHexWindow(expected, length, mismatch));
+        _WOLog(@"actual:   %@", WOHexWindow(actual, length, mismatch));
+    }
+}
+
+- (void)testData:(NSData *)actual isEqualTo:(NSData *)expected inFile:(char *)path atLine:(int)line
+{
+    if (actual && ![actual isKindOfClass:[NSData class]])
+        [NSException WOTest_raise:WO_TEST_CLASS_MISMATCH_EXCEPTION
+                           reason:WO_EXPECTED_DATA_EXCEPTION_REASON(actual)
+                           inFile:path
+                           atLine:line];
+    if (expected && ![expected isKindOfClass:[NSData class]])
+        [NSException WOTest_raise:WO_TEST_CLASS_MISMATCH_EXCEPTION
+                           reason:WO_EXPECTED_DATA_EXCEPTION_REASON(expected)
+                           inFile:path
+                           atLine:line];
+    if (!actual || !expected)
+    {
+        [self writePassed:(actual == expected) inFile:path atLine:line message:@"expected %@, got %@",
+            expected ? @"data" : @"nil", actual ? @"data" : @"nil"];
+        return;
+    }
+    const unsigned char *actualBytes    = [actual bytes];
+    const unsigned char *expectedBytes  = [expected bytes];
+    size_t actualLength                 = [actual length];
+    size_t expectedLength               = [expected length];
+    size_t length                       = MIN(actualLength, expectedLength);
+    size_t mismatch                     = WOFirstMismatch(actualBytes, expectedBytes, length);
+    BOOL equal = (mismatch == length) && (actualLength == expectedLength);
+    [self writePassed:equal inFile:path atLine:line message:@"expected %lu bytes, got %lu bytes, first difference at offset %lu",
+        (unsigned long)expectedLength, (unsigned long)actualLength, (unsigned long)mismatch];
+    if (!equal)
+    {
+        _WOLog(@"expected: %@", WOHexWindow(expectedBytes, expectedLength, mismatch));
+        _WOLog(@"actual:   %@", WOHexWindow(actualBytes, actualLength, mismatch));
+    }
+}
+
 #pragma mark -
 #pragma mark Exception test methods
 
@@ -1890,7 +3761,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected exception, got %@", [NSException WOTest_nameForException:exception]]];
+              message:@"expected exception, got %@", [NSException WOTest_nameForException:exception]];
 }
 
 - (void)testDoesNotThrowException:(id)exception inFile:(char *)path atLine:(int)line
@@ -1899,8 +3770,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:
-        [NSString stringWithFormat:@"expected no exception, got %@", [NSException WOTest_nameForException:exception]]];
+              message:@"expected no exception, got %@", [NSException WOTest_nameForException:exception]];
 }
 
 - (void)testThrowsException:(id)exception named:(NSString *)name inFile:(char *)path atLine:(int)line
@@ -1921,7 +3791,7 @@ jump_point:
     [self writePassed:result
                inFile:path
                atLine:line
-              message:[NSString stringWithFormat:@"expected %@, got %@", name, actualName]];
+              message:@"expected %@, got %@", name, actualName];
 }
 
 - (void)testDoesNotThrowException:(id)exception named:(NSString *)name inFile:(char *)path atLine:(int)line
@@ -2121,20 +3991,17 @@ jump_point:
 #pragma mark Properties
 
 @synthesize startDate;
-@synthesize testsRun;
-@synthesize testsPassed;
-@synthesize testsFailed;
-@synthesize uncaughtExceptions;
-@synthesize testsFailedExpected;
-@synthesize testsPassedUnexpected;
-@synthesize expectFailures;
-@synthesize lowLevelExceptionsExpected;
-@synthesize lowLevelExceptionsUnexpected;
 @synthesize expectLowLevelExceptions;
 @synthesize verbosity;
+@synthesize logsPassedTests;
 @synthesize trimInitialPathComponents;
-@synthesize lastReportedFile;
-@synthesize lastReportedLine;
 @synthesize warnsAboutSignComparisons;
+@synthesize catchesLowLevelExceptions;
+@synthesize stopsAfterFirstFailure;
+@synthesize stopped;
+@synthesize defaultTimeout;
+@synthesize exitsOnTimeout;
+@synthesize jobs;
+@synthesize methodDiscoveryTime;
 
 @end
@@ -21,6 +21,9 @@
 
 //! \file WOTestMacros.h
 
+// system headers
+#import <libkern/OSAtomic.h>        /* OSMemoryBarrier() */
+
 #pragma mark -
 #pragma mark Special macros
 
@@ -35,6 +38,22 @@
 //! \param class The class whose name should be protected from dead-code stripping
 #define WO_TEST_NO_DEAD_STRIP_CLASS(class) __asm__ (".no_dead_strip .objc_class_name_" #class "\n");
 
+//! Name of the Mach-O section (in the __DATA segment) holding the class names recorded by WO_TEST_REGISTER.
+#define WO_TEST_REGISTRATION_SECTION        "__wotest_reg"
+
+//! Records the name of a test class in a dedicated section of the image so that it can be discovered without asking the
+//! runtime about every class in the image. Note that once an image registers any class this way only its registered
+//! classes are discovered, so either register all of the test classes in an image or none of them.
+//! \code
+//!   @implemenation ExampleTests
+//!   WO_TEST_REGISTER(ExampleTests);
+//!   // remainder of class implementation
+//! \endcode
+//! \param class The test class to register
+#define WO_TEST_REGISTER(class)                                                                                                 \
+    __attribute__((used, section("__DATA," WO_TEST_REGISTRATION_SECTION)))                                                      \
+    static const char *WOTestRegistration_ ## class = #class
+
 #pragma mark -
 #pragma mark Bootstrap macros for unit testing within applications
 
@@ -65,7 +84,27 @@
 /*! No memory error. */
 #define WO_TEST_MEMORY_ERROR 1
 
-#define WO_TEST_SHARED_INSTANCE     (WOTest *)[NSClassFromString(@"WOTest") sharedInstance]
+@class WOTest;
+
+/*! Returns the WOTest shared instance, or nil if the framework is not loaded. Every assertion macro goes through here, so the first non-nil result is cached (once per translation unit) and later calls cost a single load instead of a class lookup plus a message send. Nil is never cached, so code which loads the framework at run time using WO_TEST_LOAD_FRAMEWORK picks up the instance as soon as the framework is loaded. */
+static inline WOTest *WOTestCachedSharedInstance(void)
+{
+    static WOTest *cachedInstance = nil;
+    WOTest *instance = cachedInstance;
+    if (!instance)
+    {
+        instance = (WOTest *)[NSClassFromString(WO_TEST_CLASS_NAME) performSelector:@selector(sharedInstance)];
+        if (instance)
+        {
+            // make sure that the initialized instance is visible to other threads before the pointer to it is
+            OSMemoryBarrier();
+            cachedInstance = instance;
+        }
+    }
+    return instance;
+}
+
+#define WO_TEST_SHARED_INSTANCE     WOTestCachedSharedInstance()
 
 #define WO_TEST_FRAMEWORK_IS_LOADED (WO_TEST_SHARED_INSTANCE ? YES : NO)
 
@@ -180,6 +219,123 @@ do {
 
 /*! \endgroup */
 
+#pragma mark -
+#pragma mark Compile-time operand classification
+
+//! \name Compile-time operand classification
+//! The generic comparison macros use these to pick a typed comparison method at compile time so that common operand types
+//! don't have to be boxed in NSValue objects and classified again at run time by matching type encoding strings. Only
+//! operand pairs which the NSValue path would compare without any implicit sign conversion (and so without any warning)
+//! take the fast path; everything else (mixed signedness, structs, SELs, C strings and so on) still goes through NSValue.
+//! \startgroup
+
+#define WO_TEST_IS_SIGNED_INTEGER(expr)                                                                                         \
+    (__builtin_types_compatible_p(typeof(expr), char)       || __builtin_types_compatible_p(typeof(expr), signed char)   ||    \
+     __builtin_types_compatible_p(typeof(expr), short)      || __builtin_types_compatible_p(typeof(expr), int)           ||    \
+     __builtin_types_compatible_p(typeof(expr), long)       || __builtin_types_compatible_p(typeof(expr), long long))
+
+#define WO_TEST_IS_UNSIGNED_INTEGER(expr)                                                                                       \
+    (__builtin_types_compatible_p(typeof(expr), unsigned char)  || __builtin_types_compatible_p(typeof(expr), unsigned short)  || \
+     __builtin_types_compatible_p(typeof(expr), unsigned int)   || __builtin_types_compatible_p(typeof(expr), unsigned long)   || \
+     __builtin_types_compatible_p(typeof(expr), unsigned long long))
+
+#define WO_TEST_IS_FLOATING_POINT(expr)                                                                                         \
+    (__builtin_types_compatible_p(typeof(expr), float) || __builtin_types_compatible_p(typeof(expr), double))
+
+//! Objects ("@") and pointers other than C strings ("^"); nil is a pointer to void on Leopard so it compares as a pointer.
+#define WO_TEST_IS_OBJECT(expr)             (@encode(typeof(expr))[0] == '@')
+#define WO_TEST_IS_POINTER(expr)            (@encode(typeof(expr))[0] == '^')
+
+//! Read an operand of one of the classified types through a pointer; going through a pointer keeps every branch of the
+//! comparison macros valid for every operand type, including those (like structs) which cannot be cast to a scalar.
+static inline long long WOTestSignedValue(const void *value, size_t size)
+{
+    switch (size)
+    {
+        case sizeof(signed char):   return *(const signed char *)value;
+        case sizeof(short):         return *(const short *)value;
+        case sizeof(int):           return *(const int *)value;
+        default:                    return *(const long long *)value;
+    }
+}
+
+static inline unsigned long long WOTestUnsignedValue(const void *value, size_t size)
+{
+    switch (size)
+    {
+        case sizeof(unsigned char):     return *(const unsigned char *)value;
+        case sizeof(unsigned short):    return *(const unsigned short *)value;
+        case sizeof(unsigned int):      return *(const unsigned int *)value;
+        default:                        return *(const unsigned long long *)value;
+    }
+}
+
+static inline double WOTestFloatingPointValue(const void *value, size_t size)
+{
+    return (size == sizeof(float)) ? *(const float *)value : *(const double *)value;
+}
+
+//! The typed comparisons shared by the generic comparison macros; \p comparison is the second part of the selector
+//! (isEqualTo, greaterThan and so on). Must be followed by an else clause.
+#define WO_TEST_COMPARE_SCALARS(actual, expected, comparison)                                                                   \
+    if (WO_TEST_IS_SIGNED_INTEGER(actual) && WO_TEST_IS_SIGNED_INTEGER(expected))                                              \
+        WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE                                                                                \
+            testLongLong:WOTestSignedValue(&WOMacroVariable1, sizeof(WOMacroVariable1))                                         \
+              comparison:WOTestSignedValue(&WOMacroVariable2, sizeof(WOMacroVariable2))                                         \
+                  inFile:__FILE__                                                                                               \
+                  atLine:__LINE__]);                                                                                            \
+    else if (WO_TEST_IS_UNSIGNED_INTEGER(actual) && WO_TEST_IS_UNSIGNED_INTEGER(expected))                                     \
+        WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE                                                                                \
+            testUnsignedLongLong:WOTestUnsignedValue(&WOMacroVariable1, sizeof(WOMacroVariable1))                               \
+                      comparison:WOTestUnsignedValue(&WOMacroVariable2, sizeof(WOMacroVariable2))                               \
+                          inFile:__FILE__                                                                                       \
+                          atLine:__LINE__]);                                                                                    \
+    else if (WO_TEST_IS_FLOATING_POINT(actual) && WO_TEST_IS_FLOATING_POINT(expected))                                         \
+        WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE                                                                                \
+            testDouble:WOTestFloatingPointValue(&WOMacroVariable1, sizeof(WOMacroVariable1))                                    \
+            comparison:WOTestFloatingPointValue(&WOMacroVariable2, sizeof(WOMacroVariable2))                                    \
+                inFile:__FILE__                                                                                                 \
+                atLine:__LINE__]);
+
+//! The general (NSValue) comparison used for all other operand types.
+#define WO_TEST_COMPARE_BOXED(actual, expected, comparison)                                                                     \
+    WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testValue:[NSValue value:&WOMacroVariable1 withObjCType:@encode(typeof(actual))]   \
+                                            comparison:[NSValue value:&WOMacroVariable2 withObjCType:@encode(typeof(expected))] \
+                                                inFile:__FILE__                                                                 \
+                                                atLine:__LINE__])
+
+//! Body of the ordering macros (WO_TEST_GREATER_THAN and so on).
+#define WO_TEST_COMPARE_VALUES(actual, expected, comparison)                                                                    \
+do {                                                                                                                            \
+    typeof(actual) WOMacroVariable1 = (actual);                                                                                 \
+    typeof(expected) WOMacroVariable2 = (expected);                                                                             \
+    WO_TEST_COMPARE_SCALARS(actual, expected, comparison)                                                                       \
+    else                                                                                                                        \
+        WO_TEST_COMPARE_BOXED(actual, expected, comparison);                                                                    \
+} while (0)
+
+//! Body of WO_TEST_EQUAL and WO_TEST_NOT_EQUAL, which can also compare objects (using isEqual:) and pointers directly.
+#define WO_TEST_COMPARE_IDENTITIES(actual, expected, comparison)                                                                \
+do {                                                                                                                            \
+    typeof(actual) WOMacroVariable1 = (actual);                                                                                 \
+    typeof(expected) WOMacroVariable2 = (expected);                                                                             \
+    WO_TEST_COMPARE_SCALARS(actual, expected, comparison)                                                                       \
+    else if (WO_TEST_IS_OBJECT(actual) && WO_TEST_IS_OBJECT(expected))                                                         \
+        WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testObject:*(id *)&WOMacroVariable1                                            \
+                                                 comparison:*(id *)&WOMacroVariable2                                            \
+                                                     inFile:__FILE__                                                            \
+                                                     atLine:__LINE__]);                                                         \
+    else if (WO_TEST_IS_POINTER(actual) && WO_TEST_IS_POINTER(expected))                                                       \
+        WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testPointer:*(void **)&WOMacroVariable1                                        \
+                                                  comparison:*(void **)&WOMacroVariable2                                        \
+                                                      inFile:__FILE__                                                           \
+                                                      atLine:__LINE__]);                                                        \
+    else                                                                                                                        \
+        WO_TEST_COMPARE_BOXED(actual, expected, comparison);                                                                    \
+} while (0)
+
+//! \endgroup
+
 #pragma mark -
 #pragma mark Generic scalar test macros without error margins
 
@@ -217,54 +373,22 @@ else
 \endcode
 
 */
-#define WO_TEST_EQUAL(actual, expected)                                                                                         \
-do {                                                                                                                            \
-    typeof(actual) WOMacroVariable1 = (actual);                                                                                 \
-    typeof(expected) WOMacroVariable2 = (expected);                                                                             \
-    WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testValue:[NSValue value:&WOMacroVariable1 withObjCType:@encode(typeof(actual))]   \
-                                             isEqualTo:[NSValue value:&WOMacroVariable2 withObjCType:@encode(typeof(expected))] \
-                                                inFile:__FILE__                                                                 \
-                                                atLine:__LINE__]);                                                              \
-} while (0)
+#define WO_TEST_EQUAL(actual, expected)    WO_TEST_COMPARE_IDENTITIES(actual, expected, isEqualTo)
 
 /*! Synonym for WO_TEST_EQUAL. "EQ" stands for "Equal". */
 #define WO_TEST_EQ(actual, expected)  WO_TEST_EQUAL(actual, expected)
 
-#define WO_TEST_NOT_EQUAL(actual, expected)                                                                                     \
-do {                                                                                                                            \
-    typeof(actual) WOMacroVariable1 = (actual);                                                                                 \
-    typeof(expected) WOMacroVariable2 = (expected);                                                                             \
-    WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testValue:[NSValue value:&WOMacroVariable1 withObjCType:@encode(typeof(actual))]   \
-                                          isNotEqualTo:[NSValue value:&WOMacroVariable2 withObjCType:@encode(typeof(expected))] \
-                                                inFile:__FILE__                                                                 \
-                                                atLine:__LINE__]);                                                              \
-} while (0)
+#define WO_TEST_NOT_EQUAL(actual, expected)    WO_TEST_COMPARE_IDENTITIES(actual, expected, isNotEqualTo)
 
 /*! Synonym for WO_TEST_NE. "NE" stands for "Not Equal". */
 #define WO_TEST_NE(actual, expected)  WO_TEST_NOT_EQUAL(actual, expected)
 
-#define WO_TEST_GREATER_THAN(actual, expected)                                                                                  \
-do {                                                                                                                            \
-    typeof(actual) WOMacroVariable1 = (actual);                                                                                 \
-    typeof(expected) WOMacroVariable2 = (expected);                                                                             \
-    WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testValue:[NSValue value:&WOMacroVariable1 withObjCType:@encode(typeof(actual))]   \
-                                           greaterThan:[NSValue value:&WOMacroVariable2 withObjCType:@encode(typeof(expected))] \
-                                                inFile:__FILE__                                                                 \
-                                                atLine:__LINE__]);                                                              \
-} while (0)
+#define WO_TEST_GREATER_THAN(actual, expected)    WO_TEST_COMPARE_VALUES(actual, expected, greaterThan)
 
 /*! Synonym for WO_TEST_GREATER_THAN. "GT" stands for "Greater Than". */
 #define WO_TEST_GT(actual, expected)  WO_TEST_GREATER_THAN(actual, expected)
 
-#define WO_TEST_NOT_GREATER_THAN(actual, expected)                                                                              \
-do {                                                                                                                            \
-    typeof(actual) WOMacroVariable1 = (actual);                                                                                 \
-    typeof(expected) WOMacroVariable2 = (expected);                                                                             \
-    WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testValue:[NSValue value:&WOMacroVariable1 withObjCType:@encode(typeof(actual))]   \
-                                        notGreaterThan:[NSValue value:&WOMacroVariable2 withObjCType:@encode(typeof(expected))] \
-                                                inFile:__FILE__                                                                 \
-                                                atLine:__LINE__]);                                                              \
-} while (0)
+#define WO_TEST_NOT_GREATER_THAN(actual, expected)    WO_TEST_COMPARE_VALUES(actual, expected, notGreaterThan)
 
 /*! Synonym for WO_TEST_NOT_GREATER_THAN. "LTE" stands for "Less Than or Equal". */
 #define WO_TEST_LTE(actual, expected) WO_TEST_NOT_GREATER_THAN(actual, expected)
@@ -272,28 +396,12 @@ do {
 /*! Synonym for WO_TEST_NOT_GREATER_THAN. "NGT" stands for "Not Greater Than". */
 #define WO_TEST_NGT(actual, expected) WO_TEST_NOT_GREATER_THAN(actual, expected)
 
-#define WO_TEST_LESS_THAN(actual, expected)                                                                                     \
-do {                                                                                                                            \
-    typeof(actual) WOMacroVariable1 = (actual);                                                                                 \
-    typeof(expected) WOMacroVariable2 = (expected);                                                                             \
-    WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testValue:[NSValue value:&WOMacroVariable1 withObjCType:@encode(typeof(actual))]   \
-                                              lessThan:[NSValue value:&WOMacroVariable2 withObjCType:@encode(typeof(expected))] \
-                                                inFile:__FILE__                                                                 \
-                                                atLine:__LINE__]);                                                              \
-} while (0)
+#define WO_TEST_LESS_THAN(actual, expected)    WO_TEST_COMPARE_VALUES(actual, expected, lessThan)
 
 /*! Synonym for WO_TEST_LESS_THAN. "LT" stands for "Less Than". */
 #define WO_TEST_LT(actual, expected)  WO_TEST_LESS_THAN(actual, expected)
 
-#define WO_TEST_NOT_LESS_THAN(actual, expected)                                                                                 \
-do {                                                                                                                            \
-    typeof(actual) WOMacroVariable1 = (actual);                                                                                 \
-    typeof(expected) WOMacroVariable2 = (expected);                                                                             \
-    WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testValue:[NSValue value:&WOMacroVariable1 withObjCType:@encode(typeof(actual))]   \
-                                           notLessThan:[NSValue value:&WOMacroVariable2 withObjCType:@encode(typeof(expected))] \
-                                                inFile:__FILE__                                                                 \
-                                                atLine:__LINE__]);                                                              \
-} while (0)
+#define WO_TEST_NOT_LESS_THAN(actual, expected)    WO_TEST_COMPARE_VALUES(actual, expected, notLessThan)
 
 /*! Synonym for WO_TEST_NOT_LESS_THAN. "GTE" stands for "Greater Than or Equal". */
 #define WO_TEST_GTE(actual, expected) WO_TEST_NOT_LESS_THAN(actual, expected)
@@ -658,6 +766,60 @@ WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testDoubleNotZero:(aDouble) withinError
 
 /*! \endgroup */
 
+#pragma mark -
+#pragma mark float and double array test macros
+
+/*! \name float and double array test macros
+\startgroup */
+
+/*! The \p elements values in each of the two float arrays should be equal, within the absolute error \p absError, the relative error \p relError (a fraction of the larger magnitude) or \p maxUlps units in the last place; a tolerance of zero is not applied. The arrays are compared in a single pass and only one result is recorded. */
+#define WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_TOLERANCE(actual, expected, elements, absError, relError, maxUlps)    \
+        WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testFloats:(actual)                                            \
+                                                 areEqualTo:(expected)                                          \
+                                                      count:(elements)                                          \
+                                              absoluteError:(absError)                                          \
+                                              relativeError:(relError)                                          \
+                                                       ulps:(maxUlps)                                           \
+                                                     inFile:__FILE__                                            \
+                                                     atLine:__LINE__])
+
+/*! The \p elements values in each of the two float arrays should be equal within the absolute margin of error \p error. */
+#define WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_ERROR(actual, expected, elements, error)  \
+        WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_TOLERANCE(actual, expected, elements, error, 0, 0)
+
+/*! The \p elements values in each of the two float arrays should be equal within the relative margin of error \p error (for example, 1e-6 for one part in a million). */
+#define WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_RELATIVE_ERROR(actual, expected, elements, error) \
+        WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_TOLERANCE(actual, expected, elements, 0, error, 0)
+
+/*! The \p elements values in each of the two float arrays should be no more than \p maxUlps representable values apart. */
+#define WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_ULPS(actual, expected, elements, maxUlps) \
+        WO_TEST_FLOAT_ARRAYS_EQUAL_WITHIN_TOLERANCE(actual, expected, elements, 0, 0, maxUlps)
+
+/*! The \p elements values in each of the two double arrays should be equal, within the absolute error \p absError, the relative error \p relError (a fraction of the larger magnitude) or \p maxUlps units in the last place; a tolerance of zero is not applied. The arrays are compared in a single pass and only one result is recorded. */
+#define WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_TOLERANCE(actual, expected, elements, absError, relError, maxUlps)    \
+        WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testDoubles:(actual)                                            \
+                                                  areEqualTo:(expected)                                          \
+                                                       count:(elements)                                          \
+                                               absoluteError:(absError)                                          \
+                                               relativeError:(relError)                                          \
+                                                        ulps:(maxUlps)                                           \
+                                                      inFile:__FILE__                                            \
+                                                      atLine:__LINE__])
+
+/*! The \p elements values in each of the two double arrays should be equal within the absolute margin of error \p error. */
+#define WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_ERROR(actual, expected, elements, error)  \
+        WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_TOLERANCE(actual, expected, elements, error, 0, 0)
+
+/*! The \p elements values in each of the two double arrays should be equal within the relative margin of error \p error (for example, 1e-6 for one part in a million). */
+#define WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_RELATIVE_ERROR(actual, expected, elements, error) \
+        WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_TOLERANCE(actual, expected, elements, 0, error, 0)
+
+/*! The \p elements values in each of the two double arrays should be no more than \p maxUlps representable values apart. */
+#define WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_ULPS(actual, expected, elements, maxUlps) \
+        WO_TEST_DOUBLE_ARRAYS_EQUAL_WITHIN_TOLERANCE(actual, expected, elements, 0, 0, maxUlps)
+
+/*! \endgroup */
+
 #pragma mark -
 #pragma mark Object test macros
 
@@ -780,6 +942,28 @@ WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testDictionary:(actual) isNotEqualTo:(e
 
 /*! \endgroup */
 
+#pragma mark -
+#pragma mark Buffer and NSData test macros
+
+/*! \name Buffer and NSData test macros
+\startgroup */
+
+/*! Tests that the \p size bytes starting at \p actual are identical to those starting at \p expected. Use this instead of looping over the elements with WO_TEST_EQ: the buffers are compared in bulk and only one result is recorded. */
+#define WO_TEST_BUFFERS_EQUAL(actual, expected, size) \
+WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testBuffer:(actual) isEqualTo:(expected) length:(size) inFile:__FILE__ atLine:__LINE__])
+
+/*! Synonym for WO_TEST_BUFFERS_EQUAL. "EQ" stands for "Equal". */
+#define WO_TEST_BUFFERS_EQ(actual, expected, size) WO_TEST_BUFFERS_EQUAL(actual, expected, size)
+
+/*! Tests that the NSData objects \p actual and \p expected contain identical bytes (two nil objects are considered equal). Raises WO_TEST_CLASS_MISMATCH_EXCEPTION if either is not an NSData object. On failure the length of both objects and a hex dump of the bytes around the first difference are printed, rather than the full description of either object. */
+#define WO_TEST_DATA_EQUAL(actual, expected)    \
+WO_TEST_WRAPPER([WO_TEST_SHARED_INSTANCE testData:(actual) isEqualTo:(expected) inFile:__FILE__ atLine:__LINE__])
+
+/*! Synonym for WO_TEST_DATA_EQUAL. "EQ" stands for "Equal". */
+#define WO_TEST_DATA_EQ(actual, expected) WO_TEST_DATA_EQUAL(actual, expected)
+
+/*! \endgroup */
+
 #pragma mark -
 #pragma mark Exception test macros
 
@@ -19,6 +19,38 @@
 //  along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#import <Foundation/Foundation.h>
+
+@class NSArray, NSDictionary, NSMutableArray, NSMutableDictionary, NSMutableSet, NSSet, NSString;
+
+#pragma mark -
+#pragma mark Types
+
+/*! Settings parsed from the commandline which determine what a test session runs and how. */
+typedef struct WOTestRunnerOptions {
+    NSMutableArray  *testClasses;
+    NSMutableSet    *excludeClasses;
+    NSMutableArray  *testMethods;
+    NSMutableArray  *excludeMethods;
+    NSMutableArray  *testBundles;
+    NSMutableArray  *excludeBundles;
+    unsigned        jobs;
+    BOOL            isolate;
+    NSString        *timingsPath;
+    BOOL            updateTimings;
+    unsigned        shardIndex;
+    unsigned        shardCount;
+    BOOL            shardBalanced;
+    BOOL            failFast;
+    NSString        *failuresPath;
+    NSTimeInterval  timeout;
+    NSMutableDictionary *classTimeouts;
+    NSString        *manifestPath;
+    NSString        *writeManifestPath;
+    BOOL            listOnly;
+    BOOL            profileStartup;
+} WOTestRunnerOptions;
+
 #pragma mark -
 #pragma mark Function declarations
 
@@ -28,5 +60,59 @@ void showUsage(const char*);
 /*! Show version information. */
 void showVersion(void);
 
+/*! Records that the startup phase described by \p phase, which began at \p began, has just finished (see printStartupProfile). */
+void recordStartupPhase(NSString *phase, CFAbsoluteTime began);
+
+/*! Records the time at which the first test method started, if not already recorded. Safe to call from any thread. */
+void noteFirstTestStarted(void);
+
+/*! Prints the time taken by each recorded startup phase (including the bundles injected by WOTestBundleInjector and method discovery) and the time from launch until the first test method started. */
+void printStartupProfile(void);
+
 /*! Return an absolute path name based on path that may be absolute or relative. */
 char *absolutePath(const char *path);
+
+/*! Load the test bundles, discover the classes to test, run them and print a summary. If \p changedNames is not nil only the classes affected by those changes are run (see affectedClassNames). Returns the exit status for the process. */
+int runTestSession(WOTestRunnerOptions *options, NSSet *changedNames);
+
+/*! Returns those of \p classNames which appear to be affected by changes to files whose names (minus extension) are in \p changedNames: a test class is affected by changes to its own source files and to those of the class it tests (so FooTests is affected by changes to FooTests.m, Foo.h and Foo.m). */
+NSArray *affectedClassNames(NSArray *classNames, NSSet *changedNames);
+
+/*! Starts this executable again as \p child, with the original arguments followed by \p extraArguments (NSStrings), using posix_spawn() so that nothing (threads, locks or Foundation state) is inherited as it would be after a bare fork(). SIGPIPE is reset to its default action in the child. Returns 0 on success or an errno value. */
+int spawnRunner(NSArray *extraArguments, pid_t *child);
+
+/*! Run a test session in a child process (see spawnRunner and runWatchSession) at startup and then every time the test bundles change. Changes to files under \p watchPaths (typically source directories) do not trigger a run by themselves but limit the next run to the affected classes. The child for each run is started as soon as the previous run finishes and waits, with the framework loaded, for this process to hand it the changes; only then does it load the test bundles, so a rebuilt bundle is always picked up. Does not return except on error. */
+int watchAndRunTests(WOTestRunnerOptions *options, NSArray *watchPaths);
+
+/*! Runs this process as a watch mode run (see the hidden --watch-run option): reads the names of the changed files, one per line and ending with an empty line, from \p triggerDescriptor, then runs runTestSession limited to the classes they affect (or all classes if there are none). Returns without running anything if end-of-file is read first. Returns the exit status for the process. */
+int runWatchSession(WOTestRunnerOptions *options, int triggerDescriptor);
+
+/*! Reads the test manifest at \p path and returns its inventory: a dictionary mapping class names to arrays of test methods (in the "+name" and "-name" format returned by the WOTest testableMethodsFrom: method). Returns nil if the file can't be read or is not a valid manifest. */
+NSDictionary *readManifest(NSString *path);
+
+/*! Writes a test manifest describing the testable methods of the classes named in \p classNames to \p path. Returns YES on success. */
+BOOL writeManifest(NSString *path, NSArray *classNames);
+
+/*! Returns the inventory (as for readManifest) of the classes named in \p classNames, taken from \p manifest if not nil or otherwise from the runtime, with any method filters applied. */
+NSDictionary *inventoryForClassNames(NSArray *classNames, NSDictionary *manifest);
+
+/*! Compares \p manifest against the runtime for the classes named in \p classNames, printing a warning for each discrepancy. Returns YES if they agree. */
+BOOL verifyManifest(NSDictionary *manifest, NSArray *classNames);
+
+/*! Prints the identifiers ("Class/-method") of the methods in \p inventory, one per line, in the order of \p classNames, restricted to the selected shard if sharding was requested in \p options. */
+void listTests(NSArray *classNames, NSDictionary *inventory, WOTestRunnerOptions *options);
+
+/*! Run the named test classes either in this process (using the jobs setting of the WOTest shared instance) or, if \p isolate is YES, in \p jobs child worker processes. \p descriptors restricts the run as for the WOTest runTestsForClassNames:descriptors: method. */
+void runTests(NSArray *classNames, NSDictionary *descriptors, BOOL isolate, unsigned jobs);
+
+/*! Returns a dictionary in the format accepted by the WOTest runTestsForClassNames:descriptors: method containing those of the methods in \p descriptors (or, if nil, all testable methods of the classes named in \p classNames) whose identifiers are (if \p included is YES) or are not (if \p included is NO) in \p identifiers. */
+NSDictionary *filterMethods(NSArray *classNames, NSDictionary *descriptors, NSSet *identifiers, BOOL included);
+
+/*! Run the named test classes in \p count long-lived child worker processes, merging the results back into the WOTest shared instance. If \p descriptors is not nil it restricts the run in the same way as the WOTest runTestsForClassNames:descriptors: method. Workers which die are replaced and the crash is recorded against the test method which was running at the time. */
+void runIsolatedTests(NSArray *classNames, NSDictionary *descriptors, unsigned count);
+
+/*! Runs this process as an isolated worker (see the hidden --worker option): loads the test bundles named in \p options, applies its time budgets and runs runWorker. Returns the exit status for the process. */
+int runWorkerSession(WOTestRunnerOptions *options, int commandDescriptor, int reportDescriptor);
+
+/*! The main loop of a worker process: reads units of work from \p commandDescriptor and writes progress records to \p reportDescriptor until end-of-file is read. */
+void runWorker(int commandDescriptor, int reportDescriptor);
@@ -21,7 +21,15 @@
 // system headers
 #import <Foundation/Foundation.h>
 #import <objc/objc-runtime.h>
+#import <fcntl.h>
 #import <getopt.h>
+#import <mach-o/dyld.h>             /* _NSGetExecutablePath() */
+#import <signal.h>
+#import <spawn.h>
+#import <sys/event.h>
+#import <sys/select.h>
+#import <sys/wait.h>
+#import <unistd.h>
 
 // framework headers
 #import "WOTest.h"
@@ -29,6 +37,53 @@
 // make what(1) produce meaningful output
 #import "WOTestRunner_Version.h"
 
+#pragma mark -
+#pragma mark Macros
+
+// long options without a short equivalent
+enum {
+    WOShardIndexOption = 256,
+    WOShardCountOption,
+    WOShardBalancedOption,
+    WOFailuresOption,
+    WOWatchPathOption,
+    WOTimeoutOption,
+    WOClassTimeoutOption,
+    WOManifestOption,
+    WOWriteManifestOption,
+    WOProfileStartupOption,
+    WOWorkerOption,
+    WOWatchRunOption
+};
+
+// keys used in test manifests
+#define WO_MANIFEST_VERSION_KEY @"WOTestManifestVersion"
+#define WO_MANIFEST_CLASSES_KEY @"Classes"
+#define WO_MANIFEST_VERSION     1
+
+// startup profile (see --profile-startup): when main() started, when the first test method started, and the phases in between
+static CFAbsoluteTime   WOLaunchTime        = 0.0;
+static CFAbsoluteTime   WOFirstTestTime     = 0.0;
+static NSMutableArray   *WOStartupPhases    = nil;
+
+// the commandline, passed on to worker processes and watch mode runs (see spawnRunner)
+static int              WOArgumentCount     = 0;
+static const char       **WOArguments       = NULL;
+
+extern char **environ;
+
+// notes when the first test method starts when running tests in this process
+@interface WOStartupObserver : NSObject {
+
+}
+
+- (void)testWillRun:(NSNotification *)aNotification;
+
+@end
+
+// how long the supervisor waits beyond a method's time budget before killing a worker which failed to exit by itself
+#define WO_TIMEOUT_GRACE_PERIOD 5.0
+
 #pragma mark -
 #pragma mark Implementation
 
@@ -37,9 +92,14 @@ int main(int argc, const char *argv[])
     objc_startCollectorThread();
     NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
     int exitCode = EXIT_SUCCESS;
+    WOLaunchTime = CFAbsoluteTimeGetCurrent();
+    WOStartupPhases = [[NSMutableArray alloc] init];
+    WOArgumentCount = argc;
+    WOArguments = argv;
 
     // an example of using the framework without linking to it
     WO_TEST_LOAD_FRAMEWORK;
+    recordStartupPhase(@"load framework", WOLaunchTime);
     if (!WO_TEST_FRAMEWORK_IS_LOADED)
     {
         exitCode = EXIT_FAILURE;
@@ -49,10 +109,36 @@ int main(int argc, const char *argv[])
 
     // parse commandline arguments
     int verbose = 0;
-    NSMutableArray *testClasses     = [NSMutableArray array];
-    NSMutableArray *excludeClasses  = [NSMutableArray array];
-    NSMutableArray *testBundles     = [NSMutableArray array];
-    NSMutableArray *excludeBundles  = [NSMutableArray array];
+    BOOL quiet = NO;
+    BOOL watch = NO;
+    BOOL worker = NO;
+    BOOL watchRun = NO;
+    BOOL timingsGiven = NO, shardIndexGiven = NO;
+    int workerCommandDescriptor = -1, workerReportDescriptor = -1;
+    int watchRunDescriptor = -1;
+    NSMutableArray *watchPaths = [NSMutableArray array];
+    WOTestRunnerOptions options;
+    options.jobs            = 1;
+    options.isolate         = NO;
+    options.timingsPath     = @"WOTestTimings.plist";
+    options.updateTimings   = YES;
+    options.shardIndex      = 0;
+    options.shardCount      = 0;
+    options.shardBalanced   = NO;
+    options.failFast        = NO;
+    options.failuresPath    = @"WOTestFailures.plist";
+    options.timeout         = 0.0;
+    options.classTimeouts   = [NSMutableDictionary dictionary];
+    options.manifestPath    = nil;
+    options.writeManifestPath = nil;
+    options.listOnly        = NO;
+    options.profileStartup  = NO;
+    options.testClasses     = [NSMutableArray array];
+    options.excludeClasses  = [NSMutableSet set];
+    options.testMethods     = [NSMutableArray array];
+    options.excludeMethods  = [NSMutableArray array];
+    options.testBundles     = [NSMutableArray array];
+    options.excludeBundles  = [NSMutableArray array];
 
     extern char *optarg;
     extern int  optind;
@@ -60,13 +146,35 @@ int main(int argc, const char *argv[])
     static struct option longopts[] = {
         { "help",           no_argument,        NULL,   'h' },
         { "verbose",        no_argument,        NULL,   'v' },
+        { "quiet",          no_argument,        NULL,   'q' },
         { "version",        no_argument,        NULL,   'V' },
         { "test-class",     required_argument,  NULL,   't' },
         { "exclude-class",  required_argument,  NULL,   'e' },
+        { "test-method",    required_argument,  NULL,   'm' },
+        { "exclude-method", required_argument,  NULL,   'M' },
         { "test-bundle",    required_argument,  NULL,   'b' },
-        { "exclude-bundle", required_argument,  NULL,   'x' }
+        { "exclude-bundle", required_argument,  NULL,   'x' },
+        { "jobs",           required_argument,  NULL,   'j' },
+        { "isolate",        no_argument,        NULL,   'i' },
+        { "timings",        required_argument,  NULL,   'T' },
+        { "shard-index",    required_argument,  NULL,   WOShardIndexOption },
+        { "shard-count",    required_argument,  NULL,   WOShardCountOption },
+        { "shard-balanced", no_argument,        NULL,   WOShardBalancedOption },
+        { "fail-fast",      no_argument,        NULL,   'f' },
+        { "failures",       required_argument,  NULL,   WOFailuresOption },
+        { "watch",          no_argument,        NULL,   'w' },
+        { "watch-path",     required_argument,  NULL,   WOWatchPathOption },
+        { "timeout",        required_argument,  NULL,   WOTimeoutOption },
+        { "class-timeout",  required_argument,  NULL,   WOClassTimeoutOption },
+        { "list",           no_argument,        NULL,   'l' },
+        { "manifest",       required_argument,  NULL,   WOManifestOption },
+        { "write-manifest", required_argument,  NULL,   WOWriteManifestOption },
+        { "profile-startup", no_argument,       NULL,   WOProfileStartupOption },
+        { "worker",         required_argument,  NULL,   WOWorkerOption }, // internal use only, so not in showUsage()
+        { "watch-run",      required_argument,  NULL,   WOWatchRunOption }, // ditto
+        { NULL,             0,                  NULL,   0   }
     };
-    while ((ch = getopt_long(argc, (char * const *)argv, "hvVt:e:b:", longopts, NULL)) != -1)
+    while ((ch = getopt_long(argc, (char * const *)argv, "hvqVt:e:m:M:b:x:j:iT:fwl", longopts, NULL)) != -1)
     {
         switch (ch)
         {
@@ -77,21 +185,112 @@ int main(int argc, const char *argv[])
             case 'v':   // be verbose
                 verbose++;
                 break;
+            case 'q':   // count passing tests without printing them
+                quiet = YES;
+                break;
             case 'V':   // show version information
                 showVersion();
                 goto cleanup;
                 break;
             case 't': // test this class
-                [testClasses addObject:[NSString stringWithUTF8String:optarg]];
+                [options.testClasses addObject:[NSString stringWithUTF8String:optarg]];
                 break;
             case 'e': // exclude this class
-                [excludeClasses addObject:[NSString stringWithUTF8String:optarg]];
+                [options.excludeClasses addObject:[NSString stringWithUTF8String:optarg]];
+                break;
+            case 'm': // test only methods matching this pattern
+                [options.testMethods addObject:[NSString stringWithUTF8String:optarg]];
+                break;
+            case 'M': // exclude methods matching this pattern
+                [options.excludeMethods addObject:[NSString stringWithUTF8String:optarg]];
                 break;
             case 'b': // test this bundle (loading into memory if necessary)
-                [testBundles addObject:[NSString stringWithUTF8String:optarg]];
+                [options.testBundles addObject:[NSString stringWithUTF8String:optarg]];
                 break;
             case 'x': // exclude this bundle
-                [excludeBundles addObject:[NSString stringWithUTF8String:optarg]];
+                [options.excludeBundles addObject:[NSString stringWithUTF8String:optarg]];
+                break;
+            case 'j': // number of worker threads (0 means one per available processor)
+                options.jobs = (unsigned)strtoul(optarg, NULL, 10);
+                if (options.jobs == 0)
+                    options.jobs = [[NSProcessInfo processInfo] activeProcessorCount];
+                break;
+            case 'i': // run tests in child worker processes
+                options.isolate = YES;
+                break;
+            case 'T': // read and write per-method durations here
+                options.timingsPath = [NSString stringWithUTF8String:optarg];
+                timingsGiven = YES;
+                break;
+            case WOShardIndexOption: // run only this shard (counting from 0)
+                options.shardIndex = (unsigned)strtoul(optarg, NULL, 10);
+                shardIndexGiven = YES;
+                break;
+            case WOShardCountOption: // split the test methods into this many shards
+                options.shardCount = (unsigned)strtoul(optarg, NULL, 10);
+                break;
+            case WOShardBalancedOption: // use recorded timings to even out the shards
+                options.shardBalanced = YES;
+                break;
+            case 'f': // stop after the first failure
+                options.failFast = YES;
+                break;
+            case WOFailuresOption: // read and update the list of failing methods here
+                options.failuresPath = [NSString stringWithUTF8String:optarg];
+                break;
+            case 'w': // keep running, re-testing whenever the bundles or sources change
+                watch = YES;
+                break;
+            case WOWatchPathOption: // also watch this file or directory for changes
+                [watchPaths addObject:[NSString stringWithUTF8String:optarg]];
+                watch = YES;
+                break;
+            case WOTimeoutOption: // default time budget for each test method
+                options.timeout = strtod(optarg, NULL);
+                break;
+            case WOClassTimeoutOption: // time budget for the methods of one class, given as CLASS:SECONDS
+            {
+                char *separator = strrchr(optarg, ':');
+                if (!separator || separator == optarg)
+                {
+                    fprintf(stderr, "error: --class-timeout expects CLASS:SECONDS\n");
+                    exitCode = EXIT_FAILURE;
+                    goto cleanup;
+                }
+                NSString *className = [[NSString alloc] initWithBytes:optarg length:(separator - optarg)
+                                                             encoding:NSUTF8StringEncoding];
+                [options.classTimeouts setObject:[NSNumber numberWithDouble:strtod(separator + 1, NULL)] forKey:className];
+                break;
+            }
+            case 'l': // list the tests instead of running them
+                options.listOnly = YES;
+                break;
+            case WOManifestOption: // take the test inventory from this manifest
+                options.manifestPath = [[NSString stringWithUTF8String:optarg] WOTest_stringByConvertingToAbsolutePath];
+                break;
+            case WOWriteManifestOption: // write a manifest of the tests instead of running them
+                options.writeManifestPath = [[NSString stringWithUTF8String:optarg] WOTest_stringByConvertingToAbsolutePath];
+                break;
+            case WOProfileStartupOption: // print how long each phase of startup took
+                options.profileStartup = YES;
+                break;
+            case WOWorkerOption: // run as a worker process for --isolate, talking to the supervisor over these descriptors
+                if (sscanf(optarg, "%d,%d", &workerCommandDescriptor, &workerReportDescriptor) != 2)
+                {
+                    fprintf(stderr, "error: --worker expects COMMANDS,REPORTS\n");
+                    exitCode = EXIT_FAILURE;
+                    goto cleanup;
+                }
+                worker = YES;
+                break;
+            case WOWatchRunOption: // run a single session for watch mode once the parent says so over this descriptor
+                if (sscanf(optarg, "%d", &watchRunDescriptor) != 1)
+                {
+                    fprintf(stderr, "error: --watch-run expects a descriptor\n");
+                    exitCode = EXIT_FAILURE;
+                    goto cleanup;
+                }
+                watchRun = YES;
                 break;
             default:
                 showUsage(argv[0]);
@@ -100,6 +299,68 @@ int main(int argc, const char *argv[])
         }
     }
 
+    if (options.shardCount == 0 && (shardIndexGiven || options.shardBalanced))
+    {
+        fprintf(stderr, "error: --shard-index and --shard-balanced require --shard-count\n");
+        exitCode = EXIT_FAILURE;
+        goto cleanup;
+    }
+    if (options.shardCount > 0 && options.shardIndex >= options.shardCount)
+    {
+        fprintf(stderr, "error: --shard-index must be less than --shard-count\n");
+        exitCode = EXIT_FAILURE;
+        goto cleanup;
+    }
+
+    // every shard must see the same timings (or balanced shards would overlap and leave gaps), so sharded runs only
+    // read the default timings file; a path given explicitly is assumed to be safe to update
+    if (options.shardCount > 0 && !timingsGiven)
+        options.updateTimings = NO;
+
+    // verbose output always includes passes, even when asked to be quiet
+    [WO_TEST_SHARED_INSTANCE setLogsPassedTests:(!quiet || verbose > 0)];
+
+    // compile method patterns once, up front; runTestSession applies them when it selects the methods to run
+    @try
+    {
+        for (NSString *pattern in options.testMethods)
+            [WO_TEST_SHARED_INSTANCE addMethodFilter:pattern excluding:NO];
+        for (NSString *pattern in options.excludeMethods)
+            [WO_TEST_SHARED_INSTANCE addMethodFilter:pattern excluding:YES];
+    }
+    @catch (NSException *e)
+    {
+        fprintf(stderr, "error: %s\n", [[e reason] UTF8String]);
+        exitCode = EXIT_FAILURE;
+        goto cleanup;
+    }
+
+    options.timingsPath     = [options.timingsPath WOTest_stringByConvertingToAbsolutePath];
+    options.failuresPath    = [options.failuresPath WOTest_stringByConvertingToAbsolutePath];
+    if (worker)
+        exitCode = runWorkerSession(&options, workerCommandDescriptor, workerReportDescriptor);
+    else if (watchRun)
+        exitCode = runWatchSession(&options, watchRunDescriptor);
+    else if (watch)
+    {
+        if ([options.testBundles count] == 0)
+        {
+            fprintf(stderr, "error: --watch requires at least one --test-bundle\n");
+            exitCode = EXIT_FAILURE;
+            goto cleanup;
+        }
+        exitCode = watchAndRunTests(&options, watchPaths);
+    }
+    else
+        exitCode = runTestSession(&options, nil);
+
+cleanup:
+    [pool drain];
+    return exitCode;
+}
+
+int runTestSession(WOTestRunnerOptions *options, NSSet *changedNames)
+{
     // TODO: automatically modify DYLD_FRAMEWORK_PATH based on passed-in bundles, restore to previous setting on exit
     // basic algorithm:
     // - save DYLD_FRAMEWORK_PATH
@@ -119,57 +380,1187 @@ int main(int argc, const char *argv[])
 
     */
 
-    if ([testBundles count] > 0) // test only these bundles
+    // with a manifest the inventory can be listed without loading any bundles or looking at the runtime
+    NSDictionary *manifest = nil;
+    if (options->manifestPath)
     {
-        for (NSString *bundlePath in testBundles)
+        manifest = readManifest(options->manifestPath);
+        if (!manifest)
+        {
+            fprintf(stderr, "error: could not read manifest %s\n", [options->manifestPath UTF8String]);
+            return EXIT_FAILURE;
+        }
+        if (options->listOnly)
+        {
+            NSMutableArray *classNames = [NSMutableArray array];
+            NSArray *candidates = ([options->testClasses count] > 0) ? options->testClasses :
+                [[manifest allKeys] sortedArrayUsingSelector:@selector(compare:)];
+            for (NSString *className in candidates)
+            {
+                if ([options->excludeClasses containsObject:className] || ![manifest objectForKey:className]) continue;
+                [classNames addObject:className];
+            }
+            listTests(classNames, inventoryForClassNames(classNames, manifest), options);
+            return EXIT_SUCCESS;
+        }
+    }
+
+    // build the list of classes to test, then run them all in one go (possibly in parallel)
+    NSMutableArray *classNames = [NSMutableArray array];
+    if ([options->testBundles count] > 0) // test only these bundles
+    {
+        BOOL bundleLoaded = NO;
+        for (NSString *bundlePath in options->testBundles)
         {
             bundlePath = [bundlePath WOTest_stringByConvertingToAbsolutePath];
+            CFAbsoluteTime began = CFAbsoluteTimeGetCurrent();
             NSBundle *bundle = [NSBundle bundleWithPath:bundlePath];
             if (bundle && [bundle load])
             {
-                if ([testClasses count] > 0) // test only these classes
-                {
-                    for (NSString *class in testClasses)
-                        [WO_TEST_SHARED_INSTANCE runTestsForClassName:class];
-                }
-                else // test all classes
+                recordStartupPhase([NSString stringWithFormat:@"load bundle %@", bundlePath], began);
+                bundleLoaded = YES;
+                if ([options->testClasses count] == 0) // test all classes
                 {
-                    NSArray *classes = [WO_TEST_SHARED_INSTANCE testableClassesFrom:bundle];
-                    for (NSString *class in classes)
+                    began = CFAbsoluteTimeGetCurrent();
+                    for (NSString *class in [WO_TEST_SHARED_INSTANCE testableClassesFrom:bundle])
                     {
-                        if ([excludeClasses containsObject:class]) continue;
-                        [WO_TEST_SHARED_INSTANCE runTestsForClassName:class];
+                        if ([options->excludeClasses containsObject:class]) continue;
+                        [classNames addObject:class];
                     }
+                    recordStartupPhase([NSString stringWithFormat:@"discover classes in %@", [bundlePath lastPathComponent]], began);
                 }
             }
             else
                 fprintf(stderr, "warning: could not load bundle %s\n", [bundlePath UTF8String]);
         }
+        if (bundleLoaded && [options->testClasses count] > 0) // test only these classes
+            [classNames addObjectsFromArray:options->testClasses];
     }
     else // test all bundles
     {
-        if ([testClasses count] > 0) // test only these classes
-        {
-            for (NSString *class in testClasses)
-                [WO_TEST_SHARED_INSTANCE runTestsForClassName:class];
-        }
+        if ([options->testClasses count] > 0) // test only these classes
+            [classNames addObjectsFromArray:options->testClasses];
         else // test all classes
         {
+            CFAbsoluteTime began = CFAbsoluteTimeGetCurrent();
             for (NSString *class in [WO_TEST_SHARED_INSTANCE testableClasses])
             {
-                if ([excludeClasses containsObject:class]) continue;
-                [WO_TEST_SHARED_INSTANCE runTestsForClassName:class];
+                if ([options->excludeClasses containsObject:class]) continue;
+                [classNames addObject:class];
             }
+            recordStartupPhase(@"discover classes", began);
+        }
+    }
+
+    if (options->writeManifestPath)
+    {
+        if (!writeManifest(options->writeManifestPath, classNames))
+        {
+            fprintf(stderr, "error: could not write manifest %s\n", [options->writeManifestPath UTF8String]);
+            return EXIT_FAILURE;
         }
+        return EXIT_SUCCESS;
+    }
+
+    if (options->listOnly)
+    {
+        listTests(classNames, inventoryForClassNames(classNames, nil), options);
+        return EXIT_SUCCESS;
     }
 
+    // a stale manifest means that anything which relied on it (a listing or a shard assignment, say) may be wrong
+    if (manifest)
+        verifyManifest(manifest, classNames);
+
+    // apply the method patterns here, once; from now on the selected methods are passed explicitly (as descriptors, so no
+    // names are formatted or parsed again), and classes with none left are dropped
+    NSDictionary *descriptors = nil;
+    if ([options->testMethods count] > 0 || [options->excludeMethods count] > 0)
+    {
+        NSMutableArray      *selectedClasses        = [NSMutableArray arrayWithCapacity:[classNames count]];
+        NSMutableDictionary *selectedDescriptors    = [NSMutableDictionary dictionaryWithCapacity:[classNames count]];
+        for (NSString *className in classNames)
+        {
+            Class aClass = NSClassFromString(className);
+            NSData *selected = aClass ? [WO_TEST_SHARED_INSTANCE selectedMethodDescriptorsFrom:aClass] : nil;
+            if ([selected length] == 0) continue;
+            [selectedClasses addObject:className];
+            [selectedDescriptors setObject:selected forKey:className];
+        }
+        classNames = selectedClasses;
+        descriptors = selectedDescriptors;
+    }
+
+    // in watch mode run only the classes affected by the changes, if any can be identified
+    if (changedNames)
+    {
+        NSArray *affected = affectedClassNames(classNames, changedNames);
+        if ([affected count] > 0)
+            classNames = [NSMutableArray arrayWithArray:affected];
+    }
+
+    // timings from previous runs let the parallel schedulers start the longest classes first
+    [WO_TEST_SHARED_INSTANCE loadTimingsFromFile:options->timingsPath];
+
+    if (options->shardCount > 0)
+        descriptors = [WO_TEST_SHARED_INSTANCE descriptorsForShard:options->shardIndex of:options->shardCount
+                                                        classNames:classNames descriptors:descriptors
+                                                          balanced:options->shardBalanced];
+
+    // methods which failed last time run first, in a pass of their own, so that regressions show up straight away
+    NSSet *previousFailures = [NSSet setWithArray:[NSArray arrayWithContentsOfFile:options->failuresPath]];
+    [WO_TEST_SHARED_INSTANCE setStopsAfterFirstFailure:options->failFast];
+    [WO_TEST_SHARED_INSTANCE setDefaultTimeout:options->timeout];
+    for (NSString *className in options->classTimeouts)
+        [WO_TEST_SHARED_INSTANCE setTimeout:[[options->classTimeouts objectForKey:className] doubleValue] forClassName:className];
+    [WO_TEST_SHARED_INSTANCE setJobs:options->jobs];
+    WOStartupObserver *observer = [[WOStartupObserver alloc] init];
+    [[NSNotificationCenter defaultCenter] addObserver:observer selector:@selector(testWillRun:)
+                                                 name:WO_TEST_WILL_RUN_METHOD_NOTIFICATION object:nil];
+    if ([previousFailures count] > 0)
+    {
+        runTests(classNames, filterMethods(classNames, descriptors, previousFailures, YES), options->isolate, options->jobs);
+        if (![WO_TEST_SHARED_INSTANCE stopped])
+            runTests(classNames, filterMethods(classNames, descriptors, previousFailures, NO), options->isolate, options->jobs);
+    }
+    else
+        runTests(classNames, descriptors, options->isolate, options->jobs);
+    [[NSNotificationCenter defaultCenter] removeObserver:observer];
+    if (options->profileStartup)
+        printStartupProfile();
+
+    // failures which were not retried this time (skipped by --fail-fast or in another shard) stay on the list
+    NSMutableSet *failures = [NSMutableSet setWithSet:previousFailures];
+    [failures minusSet:[WO_TEST_SHARED_INSTANCE passedMethods]];
+    [failures unionSet:[WO_TEST_SHARED_INSTANCE failedMethods]];
+    if (![[[failures allObjects] sortedArrayUsingSelector:@selector(compare:)] writeToFile:options->failuresPath atomically:YES])
+        fprintf(stderr, "warning: could not write failures to %s\n", [options->failuresPath UTF8String]);
+
+    if (options->updateTimings && ![WO_TEST_SHARED_INSTANCE writeTimingsToFile:options->timingsPath])
+        fprintf(stderr, "warning: could not write timings to %s\n", [options->timingsPath UTF8String]);
+
     [WO_TEST_SHARED_INSTANCE printTestResultsSummary];
-    if (![WO_TEST_SHARED_INSTANCE testsWereSuccessful])
-        exitCode = EXIT_FAILURE;
+    return [WO_TEST_SHARED_INSTANCE testsWereSuccessful] ? EXIT_SUCCESS : EXIT_FAILURE;
+}
 
-cleanup:
-    [pool drain];
-    return exitCode;
+
+void runTests(NSArray *classNames, NSDictionary *descriptors, BOOL isolate, unsigned jobs)
+{
+    if (isolate)
+        runIsolatedTests(classNames, descriptors, jobs);
+    else
+        [WO_TEST_SHARED_INSTANCE runTestsForClassNames:classNames descriptors:descriptors];
+}
+
+NSDictionary *filterMethods(NSArray *classNames, NSDictionary *descriptors, NSSet *identifiers, BOOL included)
+{
+    // look up the listed methods once per class instead of making an identifier for every candidate
+    NSMutableDictionary *listed = [NSMutableDictionary dictionary];
+    for (NSString *identifier in identifiers)
+    {
+        NSRange separator = [identifier rangeOfString:@"/"];
+        if (separator.location == NSNotFound) continue;
+        NSString *className = [identifier substringToIndex:separator.location];
+        NSMutableArray *methods = [listed objectForKey:className];
+        if (!methods)
+        {
+            methods = [NSMutableArray array];
+            [listed setObject:methods forKey:className];
+        }
+        [methods addObject:[identifier substringFromIndex:NSMaxRange(separator)]];
+    }
+
+    NSMutableDictionary *filtered = [NSMutableDictionary dictionary];
+    for (NSString *className in classNames)
+    {
+        Class aClass = NSClassFromString(className);
+        if (!aClass) continue;
+        NSData *candidates = descriptors ? [descriptors objectForKey:className] :
+            [WO_TEST_SHARED_INSTANCE testableMethodDescriptorsFrom:aClass];
+        if (!candidates) continue;
+        NSArray *methods = [listed objectForKey:className];
+        if (!methods)
+        {
+            if (!included)
+                [filtered setObject:candidates forKey:className];
+            continue;
+        }
+        NSData                          *known          = [WO_TEST_SHARED_INSTANCE descriptorsForMethods:methods ofClass:aClass];
+        const WOTestMethodDescriptor    *knownBytes     = [known bytes];
+        unsigned                        knownCount      = [known length] / sizeof(WOTestMethodDescriptor);
+        const WOTestMethodDescriptor    *candidateBytes = [candidates bytes];
+        unsigned                        candidateCount  = [candidates length] / sizeof(WOTestMethodDescriptor);
+        NSMutableData                   *selected       = [NSMutableData data];
+        for (unsigned i = 0; i < candidateCount; i++)
+        {
+            BOOL isKnown = NO;
+            for (unsigned j = 0; j < knownCount && !isKnown; j++)
+                isKnown = (candidateBytes[i].selector == knownBytes[j].selector &&
+                           candidateBytes[i].isClassMethod == knownBytes[j].isClassMethod);
+            if (isKnown == included)
+                [selected appendBytes:&candidateBytes[i] length:sizeof(WOTestMethodDescriptor)];
+        }
+        if ([selected length] > 0)
+            [filtered setObject:selected forKey:className];
+    }
+    return filtered;
+}
+
+#pragma mark -
+#pragma mark Startup profile
+
+@implementation WOStartupObserver
+
+- (void)testWillRun:(NSNotification *)aNotification
+{
+    noteFirstTestStarted();
+}
+
+@end
+
+void recordStartupPhase(NSString *phase, CFAbsoluteTime began)
+{
+    NSCParameterAssert(phase != nil);
+    NSNumber *seconds = [NSNumber numberWithDouble:CFAbsoluteTimeGetCurrent() - began];
+    [WOStartupPhases addObject:[NSArray arrayWithObjects:phase, seconds, nil]];
+}
+
+void noteFirstTestStarted(void)
+{
+    @synchronized (WOStartupPhases)
+    {
+        if (WOFirstTestTime == 0.0)
+            WOFirstTestTime = CFAbsoluteTimeGetCurrent();
+    }
+}
+
+void printStartupProfile(void)
+{
+    // bundles named in WOTestInjectBundle are loaded by the framework's +load method, so they count towards loading the framework
+    NSArray *injected = [NSClassFromString(@"WOTestBundleInjector") bundleLoadTimes];
+    fprintf(stderr, "Startup profile:\n");
+    for (NSArray *phase in WOStartupPhases)
+    {
+        fprintf(stderr, "  %9.4fs  %s\n", [[phase objectAtIndex:1] doubleValue], [[phase objectAtIndex:0] UTF8String]);
+        if ([[phase objectAtIndex:0] isEqualToString:@"load framework"])
+            for (NSArray *bundle in injected)
+                fprintf(stderr, "  %9.4fs    inject bundle %s\n", [[bundle objectAtIndex:1] doubleValue],
+                        [[bundle objectAtIndex:0] UTF8String]);
+    }
+    fprintf(stderr, "  %9.4fs  discover methods (all classes, cumulative)\n", [WO_TEST_SHARED_INSTANCE methodDiscoveryTime]);
+    if (WOFirstTestTime > 0.0)
+        fprintf(stderr, "  %9.4fs  launch until first test started\n", WOFirstTestTime - WOLaunchTime);
+    else
+        fprintf(stderr, "          -  no tests were run\n");
+}
+
+#pragma mark -
+#pragma mark Manifests
+
+NSDictionary *readManifest(NSString *path)
+{
+    NSCParameterAssert(path != nil);
+    NSDictionary *manifest = [NSDictionary dictionaryWithContentsOfFile:path];
+    if (![[manifest objectForKey:WO_MANIFEST_VERSION_KEY] isEqual:[NSNumber numberWithInt:WO_MANIFEST_VERSION]])
+        return nil;
+    NSDictionary *classes = [manifest objectForKey:WO_MANIFEST_CLASSES_KEY];
+    if (![classes isKindOfClass:[NSDictionary class]])
+        return nil;
+    for (NSString *className in classes)
+    {
+        NSArray *methods = [classes objectForKey:className];
+        if (![methods isKindOfClass:[NSArray class]])
+            return nil;
+        for (NSString *method in methods)
+            if (![method isKindOfClass:[NSString class]] || ![method length]) return nil;
+    }
+    return classes;
+}
+
+BOOL writeManifest(NSString *path, NSArray *classNames)
+{
+    NSCParameterAssert(path != nil);
+    NSCParameterAssert(classNames != nil);
+    NSDictionary *manifest = [NSDictionary dictionaryWithObjectsAndKeys:
+        [NSNumber numberWithInt:WO_MANIFEST_VERSION],   WO_MANIFEST_VERSION_KEY,
+        inventoryForClassNames(classNames, nil),        WO_MANIFEST_CLASSES_KEY, nil];
+    return [manifest writeToFile:path atomically:YES];
+}
+
+NSDictionary *inventoryForClassNames(NSArray *classNames, NSDictionary *manifest)
+{
+    NSMutableDictionary *inventory = [NSMutableDictionary dictionaryWithCapacity:[classNames count]];
+    for (NSString *className in classNames)
+    {
+        if (manifest)
+        {
+            NSMutableArray *methods = [NSMutableArray array];
+            for (NSString *method in [manifest objectForKey:className])
+                if ([WO_TEST_SHARED_INSTANCE method:method passesFiltersForClassName:className])
+                    [methods addObject:method];
+            [inventory setObject:methods forKey:className];
+        }
+        else
+        {
+            Class aClass = NSClassFromString(className);
+            if (aClass)
+                [inventory setObject:[WO_TEST_SHARED_INSTANCE selectedMethodsFrom:aClass] forKey:className];
+        }
+    }
+    return inventory;
+}
+
+BOOL verifyManifest(NSDictionary *manifest, NSArray *classNames)
+{
+    BOOL agrees = YES;
+    NSDictionary *runtime = inventoryForClassNames(classNames, nil);
+    NSDictionary *listed = inventoryForClassNames(classNames, manifest);
+    for (NSString *className in classNames)
+    {
+        if (![manifest objectForKey:className])
+        {
+            fprintf(stderr, "warning: class %s is not in the manifest\n", [className UTF8String]);
+            agrees = NO;
+            continue;
+        }
+        NSSet *actual = [NSSet setWithArray:[runtime objectForKey:className]];
+        NSSet *expected = [NSSet setWithArray:[listed objectForKey:className]];
+        for (NSString *method in [[actual allObjects] sortedArrayUsingSelector:@selector(compare:)])
+        {
+            if ([expected containsObject:method]) continue;
+            fprintf(stderr, "warning: %s is not in the manifest\n",
+                    [[WO_TEST_SHARED_INSTANCE identifierForMethod:method ofClassName:className] UTF8String]);
+            agrees = NO;
+        }
+        for (NSString *method in [[expected allObjects] sortedArrayUsingSelector:@selector(compare:)])
+        {
+            if ([actual containsObject:method]) continue;
+            fprintf(stderr, "warning: %s is in the manifest but not in the runtime\n",
+                    [[WO_TEST_SHARED_INSTANCE identifierForMethod:method ofClassName:className] UTF8String]);
+            agrees = NO;
+        }
+    }
+    if (!agrees)
+        fprintf(stderr, "warning: the manifest is out of date; regenerate it with --write-manifest\n");
+    return agrees;
+}
+
+void listTests(NSArray *classNames, NSDictionary *inventory, WOTestRunnerOptions *options)
+{
+    if (options->shardCount > 0)
+    {
+        [WO_TEST_SHARED_INSTANCE loadTimingsFromFile:options->timingsPath];
+        inventory = [WO_TEST_SHARED_INSTANCE methodsForShard:options->shardIndex of:options->shardCount classNames:classNames
+                                                   inventory:inventory balanced:options->shardBalanced];
+    }
+    for (NSString *className in classNames)
+        for (NSString *method in [inventory objectForKey:className])
+            fprintf(stdout, "%s\n", [[WO_TEST_SHARED_INSTANCE identifierForMethod:method ofClassName:className] UTF8String]);
+    fflush(stdout);
+}
+
+#pragma mark -
+#pragma mark Spawning
+
+int spawnRunner(NSArray *extraArguments, pid_t *child)
+{
+    NSCParameterAssert(child != NULL);
+    char        path[PATH_MAX];
+    uint32_t    size    = sizeof(path);
+    if (_NSGetExecutablePath(path, &size) != 0)
+        return ENOENT;
+
+    unsigned extraCount = [extraArguments count];
+    const char **arguments = malloc(sizeof(char *) * (WOArgumentCount + extraCount + 1));
+    NSCAssert(arguments != NULL, @"malloc() failed");
+    arguments[0] = path;
+    for (int i = 1; i < WOArgumentCount; i++)
+        arguments[i] = WOArguments[i];
+    for (unsigned i = 0; i < extraCount; i++)
+        arguments[WOArgumentCount + i] = [[extraArguments objectAtIndex:i] UTF8String];
+    arguments[WOArgumentCount + extraCount] = NULL;
+
+    // the supervisor of isolated workers ignores SIGPIPE, but a child whose parent has gone away should just die
+    posix_spawnattr_t   attributes;
+    sigset_t            defaults;
+    posix_spawnattr_init(&attributes);
+    sigemptyset(&defaults);
+    sigaddset(&defaults, SIGPIPE);
+    posix_spawnattr_setsigdefault(&attributes, &defaults);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGDEF);
+    int error = posix_spawn(child, path, NULL, &attributes, (char * const *)arguments, environ);
+    posix_spawnattr_destroy(&attributes);
+    free(arguments);
+    return error;
+}
+
+#pragma mark -
+#pragma mark Watch mode
+
+#ifndef O_EVTONLY
+#define O_EVTONLY   O_RDONLY
+#endif
+
+NSArray *affectedClassNames(NSArray *classNames, NSSet *changedNames)
+{
+    NSMutableArray *affected = [NSMutableArray array];
+    for (NSString *className in classNames)
+    {
+        for (NSString *name in changedNames)
+        {
+            if ([className isEqualToString:name] ||
+                [className isEqualToString:[name stringByAppendingString:@"Tests"]] ||
+                [className isEqualToString:[name stringByAppendingString:@"Test"]])
+            {
+                [affected addObject:className];
+                break;
+            }
+        }
+    }
+    return affected;
+}
+
+// registers every file and directory under paths (skipping hidden ones) with the kqueue and returns a dictionary mapping
+// the open descriptors (NSNumbers) to their paths; closing a descriptor is enough to remove it from the kqueue again
+static NSMutableDictionary *WOWatchPaths(int kq, NSArray *paths)
+{
+    NSMutableDictionary *watched    = [NSMutableDictionary dictionary];
+    NSFileManager       *manager    = [NSFileManager defaultManager];
+    BOOL                warned      = NO;
+    for (NSString *root in paths)
+    {
+        NSMutableArray *candidates = [NSMutableArray arrayWithObject:root];
+        BOOL isDirectory;
+        if ([manager fileExistsAtPath:root isDirectory:&isDirectory] && isDirectory)
+        {
+            NSDirectoryEnumerator *enumerator = [manager enumeratorAtPath:root];
+            for (NSString *relative in enumerator)
+            {
+                if ([[relative lastPathComponent] hasPrefix:@"."])
+                {
+                    [enumerator skipDescendents];
+                    continue;
+                }
+                [candidates addObject:[root stringByAppendingPathComponent:relative]];
+            }
+        }
+        for (NSString *path in candidates)
+        {
+            int descriptor = open([path fileSystemRepresentation], O_EVTONLY);
+            if (descriptor == -1)
+            {
+                if (errno == EMFILE && !warned)
+                {
+                    fprintf(stderr, "warning: too many files to watch; some changes may go unnoticed\n");
+                    warned = YES;
+                }
+                continue;
+            }
+            struct kevent change;
+            EV_SET(&change, descriptor, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+                   NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB | NOTE_DELETE | NOTE_RENAME, 0, NULL);
+            if (kevent(kq, &change, 1, NULL, 0, NULL) == -1)
+            {
+                close(descriptor);
+                continue;
+            }
+            [watched setObject:path forKey:[NSNumber numberWithInt:descriptor]];
+        }
+    }
+    return watched;
+}
+
+// starts the process for a watch mode run, which waits for the names of the changed files on the pipe whose write end is
+// returned in trigger; returns the process identifier, or -1 on failure
+static pid_t WOSpawnWatchRun(int *trigger)
+{
+    int descriptors[2];
+    if (pipe(descriptors) == -1)
+    {
+        perror("error: pipe");
+        return -1;
+    }
+    fcntl(descriptors[1], F_SETFD, FD_CLOEXEC);
+    pid_t child;
+    NSString *option = [NSString stringWithFormat:@"--watch-run=%d", descriptors[0]];
+    int error = spawnRunner([NSArray arrayWithObject:option], &child);
+    close(descriptors[0]);
+    if (error)
+    {
+        fprintf(stderr, "error: could not start test run: %s\n", strerror(error));
+        close(descriptors[1]);
+        return -1;
+    }
+    *trigger = descriptors[1];
+    return child;
+}
+
+int watchAndRunTests(WOTestRunnerOptions *options, NSArray *watchPaths)
+{
+    int kq = kqueue();
+    if (kq == -1)
+    {
+        perror("error: kqueue");
+        return EXIT_FAILURE;
+    }
+    fcntl(kq, F_SETFD, FD_CLOEXEC);
+
+    NSMutableArray *bundlePaths = [NSMutableArray array];
+    for (NSString *bundlePath in options->testBundles)
+        [bundlePaths addObject:[bundlePath WOTest_stringByConvertingToAbsolutePath]];
+    NSMutableArray *sourcePaths = [NSMutableArray array];
+    for (NSString *sourcePath in watchPaths)
+        [sourcePaths addObject:[sourcePath WOTest_stringByConvertingToAbsolutePath]];
+    NSArray *allPaths = [bundlePaths arrayByAddingObjectsFromArray:sourcePaths];
+
+    // the pending run is told what changed by writing to its trigger pipe, so don't die if it has gone away
+    signal(SIGPIPE, SIG_IGN);
+
+    // names of source files changed since the last run (empty for the first run, which tests everything)
+    NSMutableSet *changedNames = [NSMutableSet set];
+    int trigger;
+    pid_t child = WOSpawnWatchRun(&trigger);
+    while (1)
+    {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        if (child != -1)
+        {
+            // the pending run has already loaded the framework; it loads the (possibly rebuilt) bundles afresh only now,
+            // so nothing leaks from one run into the next
+            FILE *stream = fdopen(trigger, "w");
+            if (stream)
+            {
+                for (NSString *name in changedNames)
+                    fprintf(stream, "%s\n", [name UTF8String]);
+                fputc('\n', stream);
+                fclose(stream);
+            }
+            else
+            {
+                perror("error: fdopen");
+                close(trigger);
+            }
+            int status;
+            pid_t reaped;
+            while ((reaped = waitpid(child, &status, 0)) == -1 && errno == EINTR);
+            if (reaped == -1)
+                perror("error: waitpid");
+            else if (WIFSIGNALED(status))
+                fprintf(stderr, "warning: test run terminated by signal %d (%s)\n", WTERMSIG(status), strsignal(WTERMSIG(status)));
+        }
+
+        // start the process for the next run straight away, so that its startup overlaps the wait for changes
+        child = WOSpawnWatchRun(&trigger);
+        changedNames = [NSMutableSet set];
+        fprintf(stdout, "Watching for changes (press Control-C to stop)...\n");
+        fflush(stdout);
+
+        // files are re-registered each time round because builds and editors often replace them rather than rewriting them
+        NSMutableDictionary *watched = WOWatchPaths(kq, allPaths);
+        BOOL bundleChanged = NO;
+        while (!bundleChanged)
+        {
+            // block until something changes, then keep collecting until things settle so that a whole build (or a
+            // multi-file save) produces a single run
+            struct kevent   event;
+            struct timespec settle  = { 0, 250000000 };
+            int             count   = kevent(kq, NULL, 0, &event, 1, NULL);
+            while (count > 0)
+            {
+                NSString *path = [watched objectForKey:[NSNumber numberWithInt:(int)event.ident]];
+                BOOL inBundle = NO;
+                for (NSString *bundlePath in bundlePaths)
+                {
+                    if ([path hasPrefix:bundlePath])
+                    {
+                        inBundle = YES;
+                        break;
+                    }
+                }
+                if (inBundle)
+                    bundleChanged = YES;
+                else if (path)
+                    [changedNames addObject:[[path lastPathComponent] stringByDeletingPathExtension]];
+                count = kevent(kq, NULL, 0, &event, 1, &settle);
+            }
+            if (count == -1 && errno != EINTR)
+            {
+                perror("error: kevent");
+                if (child != -1)
+                    close(trigger); // the pending run exits when it reads end-of-file
+                return EXIT_FAILURE;
+            }
+        }
+        for (NSNumber *descriptor in watched)
+            close([descriptor intValue]);
+        [pool drain];
+    }
+    return EXIT_SUCCESS;
+}
+
+int runWatchSession(WOTestRunnerOptions *options, int triggerDescriptor)
+{
+    FILE *trigger = fdopen(triggerDescriptor, "r");
+    if (!trigger)
+    {
+        perror("error: fdopen");
+        return EXIT_FAILURE;
+    }
+
+    // one changed name per line, ending with an empty line; end-of-file first means the parent has gone away
+    NSMutableSet *changedNames = [NSMutableSet set];
+    char *line;
+    size_t length;
+    while ((line = fgetln(trigger, &length)))
+    {
+        if (length > 0 && line[length - 1] == '\n')
+            length--;
+        if (length == 0)
+            break;
+        [changedNames addObject:[[NSString alloc] initWithBytes:line length:length encoding:NSUTF8StringEncoding]];
+    }
+    BOOL triggered = (line != NULL);
+    fclose(trigger);
+    if (!triggered)
+        return EXIT_SUCCESS;
+
+    // time to first test is measured from the trigger; the launch may have been long before
+    WOLaunchTime = CFAbsoluteTimeGetCurrent();
+    return runTestSession(options, ([changedNames count] > 0) ? changedNames : nil);
+}
+
+#pragma mark -
+#pragma mark Isolated worker processes
+
+/*
+
+ Workers are started by spawnRunner with a hidden --worker=COMMANDS,REPORTS option naming the inherited pipe
+ descriptors. Supervisor and workers talk over the pair of pipes using tab-separated, newline-terminated records.
+
+ Supervisor to worker (one unit of work per line):
+
+    ClassName[<tab>method...]       run the listed methods of ClassName (all testable methods if none are listed)
+
+ Worker to supervisor:
+
+    begin<tab>method                method is about to run
+    end<tab>method<tab>seconds<tab>failed<tab>counters
+                                    method finished after the given number of seconds; failed is 1 if it failed and 0
+                                    otherwise; counters are the 8 WOTestResults fields accumulated while it ran
+    done                            the unit is finished and the worker is ready for another
+
+ A worker which reaches end-of-file on its command pipe exits. A supervisor which reaches end-of-file on a report pipe while a unit is outstanding assumes the worker has crashed.
+
+*/
+
+#define WO_RESULTS_FORMAT   "%u\t%u\t%u\t%u\t%u\t%u\t%u\t%u"
+
+@interface WOTestWorker : NSObject {
+
+    pid_t           pid;
+    int             commandDescriptor;
+    int             reportDescriptor;
+
+    //! Bytes read from the report pipe which do not yet form a complete line.
+    NSMutableData   *buffer;
+
+    //! The unit of work currently being run (nil when idle); the first element is the class name and the rest are method names.
+    NSArray         *unit;
+
+    //! Methods in the current unit which have run to completion.
+    NSMutableSet    *finishedMethods;
+
+    //! The method most recently begun but not yet ended, and when it began.
+    NSString        *currentMethod;
+    NSDate          *currentMethodStart;
+
+    //! Set once the supervisor has killed the worker for exceeding its time budget.
+    BOOL            killed;
+
+    //! Set once the worker process has been reaped, along with its status as returned by waitpid().
+    BOOL            exited;
+    int             exitStatus;
+
+    //! Used in the worker process only: the report pipe wrapped in a stream, and the counters at the start of the current method.
+    FILE            *reportStream;
+    WOTestResults   startResults;
+}
+
++ (WOTestWorker *)spawnWorker;
+
+- (id)initWithProcessIdentifier:(pid_t)aPid commandDescriptor:(int)aCommandDescriptor reportDescriptor:(int)aReportDescriptor;
+
+/*! Returns NO if the worker process has exited (reaping it if so). */
+- (BOOL)isAlive;
+
+/*! Sends \p aUnit to the worker. Returns NO, leaving the worker idle, if it could not be sent because the worker has gone away. */
+- (BOOL)runUnit:(NSArray *)aUnit;
+
+/*! Reads and processes whatever is available on the report pipe. Returns NO if the worker has gone away. */
+- (BOOL)readReports;
+
+/*! Reaps the (dead) worker process, records the crash and returns the part of the current unit which never got to run, or nil if there is nothing left to retry. */
+- (NSArray *)reapAfterCrash;
+
+/*! Kills the worker if its current method has overrun its time budget by more than WO_TIMEOUT_GRACE_PERIOD; normally the worker's own watchdog will already have made it exit. */
+- (void)killIfOverdue;
+
+/*! Closes the command pipe, causing the worker to exit, and waits for it to do so. */
+- (void)terminate;
+
+@property(readonly) pid_t   pid;
+@property(readonly) int     commandDescriptor;
+@property(readonly) int     reportDescriptor;
+@property(readonly) NSArray *unit;
+
+@end
+
+@implementation WOTestWorker
+
++ (WOTestWorker *)spawnWorker
+{
+    int commands[2], reports[2];
+    if (pipe(commands) == -1)
+    {
+        perror("error: pipe");
+        return nil;
+    }
+    if (pipe(reports) == -1)
+    {
+        perror("error: pipe");
+        close(commands[0]);
+        close(commands[1]);
+        return nil;
+    }
+
+    // the supervisor's ends must not be inherited by this worker or any later one, or end-of-file would never be seen
+    fcntl(commands[1], F_SETFD, FD_CLOEXEC);
+    fcntl(reports[0], F_SETFD, FD_CLOEXEC);
+
+    pid_t child;
+    NSString *workerOption = [NSString stringWithFormat:@"--worker=%d,%d", commands[0], reports[1]];
+    int error = spawnRunner([NSArray arrayWithObject:workerOption], &child);
+    close(commands[0]);
+    close(reports[1]);
+    if (error)
+    {
+        fprintf(stderr, "error: could not start worker process: %s\n", strerror(error));
+        close(commands[1]);
+        close(reports[0]);
+        return nil;
+    }
+    return [[self alloc] initWithProcessIdentifier:child commandDescriptor:commands[1] reportDescriptor:reports[0]];
+}
+
+- (id)initWithProcessIdentifier:(pid_t)aPid commandDescriptor:(int)aCommandDescriptor reportDescriptor:(int)aReportDescriptor
+{
+    if ((self = [super init]))
+    {
+        pid                 = aPid;
+        commandDescriptor   = aCommandDescriptor;
+        reportDescriptor    = aReportDescriptor;
+        buffer              = [NSMutableData data];
+        finishedMethods     = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (BOOL)isAlive
+{
+    if (exited)
+        return NO;
+    pid_t result;
+    while ((result = waitpid(pid, &exitStatus, WNOHANG)) == -1 && errno == EINTR);
+    if (result == 0)
+        return YES;
+    exited = YES;
+    return NO;
+}
+
+- (BOOL)runUnit:(NSArray *)aUnit
+{
+    NSParameterAssert(aUnit != nil);
+    NSParameterAssert([aUnit count] > 0);
+    NSAssert(unit == nil, @"worker is already busy");
+    currentMethod = nil;
+    [finishedMethods removeAllObjects];
+
+    NSData *line = [[[aUnit componentsJoinedByString:@"\t"] stringByAppendingString:@"\n"] dataUsingEncoding:NSUTF8StringEncoding];
+    const char *bytes = [line bytes];
+    size_t remaining = [line length];
+    while (remaining > 0)
+    {
+        ssize_t written = write(commandDescriptor, bytes, remaining);
+        if (written == -1)
+        {
+            if (errno == EINTR) continue;
+            return NO; // worker has gone away before it could be given anything to do
+        }
+        bytes += written;
+        remaining -= written;
+    }
+    unit = aUnit;
+    return YES;
+}
+
+- (void)processReport:(NSString *)report
+{
+    NSArray *fields = [report componentsSeparatedByString:@"\t"];
+    NSString *kind = [fields objectAtIndex:0];
+    if ([kind isEqualToString:@"begin"] && [fields count] > 1)
+    {
+        noteFirstTestStarted();
+        currentMethod = [fields objectAtIndex:1];
+        currentMethodStart = [NSDate date];
+    }
+    else if ([kind isEqualToString:@"end"] && [fields count] == 12 && unit)
+    {
+        NSString *className = [unit objectAtIndex:0];
+        NSString *method = [fields objectAtIndex:1];
+        [finishedMethods addObject:method];
+        if ([method isEqualToString:currentMethod])
+            currentMethod = nil;
+
+        [WO_TEST_SHARED_INSTANCE recordDuration:[[fields objectAtIndex:2] doubleValue] forMethod:method ofClassName:className];
+        [WO_TEST_SHARED_INSTANCE recordResult:![[fields objectAtIndex:3] boolValue] forMethod:method ofClassName:className];
+
+        WOTestResults results;
+        NSArray *counters = [fields subarrayWithRange:NSMakeRange(4, 8)];
+        if (sscanf([[counters componentsJoinedByString:@"\t"] UTF8String], WO_RESULTS_FORMAT,
+                   &results.testsRun, &results.testsPassed, &results.testsFailed, &results.uncaughtExceptions,
+                   &results.testsFailedExpected, &results.testsPassedUnexpected, &results.lowLevelExceptionsExpected,
+                   &results.lowLevelExceptionsUnexpected) == 8)
+            [WO_TEST_SHARED_INSTANCE addResults:results];
+        else
+            fprintf(stderr, "warning: malformed report from worker %d: %s\n", pid, [report UTF8String]);
+    }
+    else if ([kind isEqualToString:@"done"])
+    {
+        unit = nil;
+        currentMethod = nil;
+    }
+    else
+        fprintf(stderr, "warning: malformed report from worker %d: %s\n", pid, [report UTF8String]);
+}
+
+- (BOOL)readReports
+{
+    char bytes[4096];
+    ssize_t count;
+    do
+        count = read(reportDescriptor, bytes, sizeof(bytes));
+    while (count == -1 && errno == EINTR);
+    if (count <= 0)
+        return NO;
+    [buffer appendBytes:bytes length:count];
+
+    // process complete lines, leaving any trailing partial line in the buffer
+    const char *start = [buffer bytes];
+    const char *end = start + [buffer length];
+    const char *line = start;
+    const char *newline;
+    while ((newline = memchr(line, '\n', end - line)))
+    {
+        NSString *report = [[NSString alloc] initWithBytes:line length:(newline - line) encoding:NSUTF8StringEncoding];
+        if (report)
+            [self processReport:report];
+        line = newline + 1;
+    }
+    [buffer replaceBytesInRange:NSMakeRange(0, line - start) withBytes:NULL length:0];
+    return YES;
+}
+
+- (NSArray *)reapAfterCrash
+{
+    if (!exited)
+        while (waitpid(pid, &exitStatus, 0) == -1 && errno == EINTR);
+    exited = YES;
+    int status = exitStatus;
+    close(commandDescriptor);
+    close(reportDescriptor);
+
+    NSString *cause;
+    if (WIFSIGNALED(status))
+        cause = [NSString stringWithFormat:@"signal %d (%s)", WTERMSIG(status), strsignal(WTERMSIG(status))];
+    else
+        cause = [NSString stringWithFormat:@"exit status %d", WEXITSTATUS(status)];
+
+    if (!unit)
+    {
+        fprintf(stderr, "warning: idle worker process %d terminated with %s\n", pid, [cause UTF8String]);
+        return nil;
+    }
+
+    NSString *className = [unit objectAtIndex:0];
+    WOTestResults crash = { 0 };
+    crash.lowLevelExceptionsUnexpected = 1;
+    [WO_TEST_SHARED_INSTANCE addResults:crash];
+    if (currentMethod)
+    {
+        [WO_TEST_SHARED_INSTANCE writeError:@"worker process %d terminated with %@ while running %@ %@", pid, cause, className,
+         currentMethod];
+        [WO_TEST_SHARED_INSTANCE recordResult:NO forMethod:currentMethod ofClassName:className];
+    }
+    else
+    {
+        // crashed outside of any test method (for example, in +initialize or preflight); retrying would only crash again
+        [WO_TEST_SHARED_INSTANCE writeError:@"worker process %d terminated with %@ while running %@", pid, cause, className];
+        return nil;
+    }
+
+    // requeue whatever did not get to run, preserving the original order
+    NSArray *methods;
+    if ([unit count] > 1)
+        methods = [unit subarrayWithRange:NSMakeRange(1, [unit count] - 1)];
+    else
+    {
+        Class aClass = NSClassFromString(className);
+        methods = aClass ? [WO_TEST_SHARED_INSTANCE testableMethodsFrom:aClass] : [NSArray array];
+    }
+    NSMutableArray *remaining = [NSMutableArray arrayWithObject:className];
+    for (NSString *method in methods)
+    {
+        if ([finishedMethods containsObject:method] || [method isEqualToString:currentMethod]) continue;
+        [remaining addObject:method];
+    }
+    return ([remaining count] > 1) ? remaining : nil;
+}
+
+- (void)killIfOverdue
+{
+    if (!unit || !currentMethod || killed)
+        return;
+    NSTimeInterval timeout = [WO_TEST_SHARED_INSTANCE timeoutForClassName:[unit objectAtIndex:0]];
+    if (timeout <= 0.0 || -[currentMethodStart timeIntervalSinceNow] < timeout + WO_TIMEOUT_GRACE_PERIOD)
+        return;
+    [WO_TEST_SHARED_INSTANCE writeError:@"killing worker process %d: test method %@ of class %@ exceeded its time budget of %.1f seconds",
+     pid, currentMethod, [unit objectAtIndex:0], timeout];
+    kill(pid, SIGKILL);
+    killed = YES;
+}
+
+- (void)terminate
+{
+    close(commandDescriptor);
+    if (!exited)
+        while (waitpid(pid, &exitStatus, 0) == -1 && errno == EINTR);
+    exited = YES;
+    close(reportDescriptor);
+}
+
+#pragma mark -
+#pragma mark Worker-side notification handling
+
+- (void)testWillRun:(NSNotification *)aNotification
+{
+    startResults = [WO_TEST_SHARED_INSTANCE results];
+    fprintf(reportStream, "begin\t%s\n", [[[aNotification userInfo] objectForKey:WO_TEST_METHOD_KEY] UTF8String]);
+    fflush(reportStream);
+}
+
+- (void)testDidRun:(NSNotification *)aNotification
+{
+    WOTestResults now = [WO_TEST_SHARED_INSTANCE results];
+    fprintf(reportStream, "end\t%s\t%f\t%d\t" WO_RESULTS_FORMAT "\n",
+            [[[aNotification userInfo] objectForKey:WO_TEST_METHOD_KEY] UTF8String],
+            [[[aNotification userInfo] objectForKey:WO_TEST_DURATION_KEY] doubleValue],
+            [[[aNotification userInfo] objectForKey:WO_TEST_FAILED_KEY] boolValue] ? 1 : 0,
+            now.testsRun                        - startResults.testsRun,
+            now.testsPassed                     - startResults.testsPassed,
+            now.testsFailed                     - startResults.testsFailed,
+            now.uncaughtExceptions              - startResults.uncaughtExceptions,
+            now.testsFailedExpected             - startResults.testsFailedExpected,
+            now.testsPassedUnexpected           - startResults.testsPassedUnexpected,
+            now.lowLevelExceptionsExpected      - startResults.lowLevelExceptionsExpected,
+            now.lowLevelExceptionsUnexpected    - startResults.lowLevelExceptionsUnexpected);
+    fflush(reportStream);
+}
+
+- (void)runUnitsFromStream:(FILE *)commands reportingTo:(FILE *)reports
+{
+    reportStream = reports;
+    NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+    [center addObserver:self selector:@selector(testWillRun:) name:WO_TEST_WILL_RUN_METHOD_NOTIFICATION object:nil];
+    [center addObserver:self selector:@selector(testDidRun:) name:WO_TEST_DID_RUN_METHOD_NOTIFICATION object:nil];
+
+    char *line;
+    size_t length;
+    while ((line = fgetln(commands, &length)))
+    {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        if (length > 0 && line[length - 1] == '\n')
+            length--;
+        NSString *command = [[NSString alloc] initWithBytes:line length:length encoding:NSUTF8StringEncoding];
+        NSArray *fields = [command componentsSeparatedByString:@"\t"];
+        Class aClass = ([fields count] > 0) ? NSClassFromString([fields objectAtIndex:0]) : Nil;
+        if (aClass)
+        {
+            NSArray *methods = ([fields count] > 1) ? [fields subarrayWithRange:NSMakeRange(1, [fields count] - 1)] : nil;
+            [WO_TEST_SHARED_INSTANCE runTestsForClass:aClass methods:methods];
+        }
+        else
+            [WO_TEST_SHARED_INSTANCE writeError:@"worker process %d could not find class for command \"%@\"", getpid(), command];
+        fprintf(reports, "done\n");
+        fflush(reports);
+        [pool drain];
+    }
+
+    [center removeObserver:self];
+}
+
+@synthesize pid;
+@synthesize commandDescriptor;
+@synthesize reportDescriptor;
+@synthesize unit;
+
+@end
+
+int runWorkerSession(WOTestRunnerOptions *options, int commandDescriptor, int reportDescriptor)
+{
+    // the supervisor sends class names, so the bundles have to be loaded here too; it lists the methods to run whenever it
+    // has selected some, so the method filters aren't needed
+    for (NSString *bundlePath in options->testBundles)
+    {
+        bundlePath = [bundlePath WOTest_stringByConvertingToAbsolutePath];
+        NSBundle *bundle = [NSBundle bundleWithPath:bundlePath];
+        if (!bundle || ![bundle load])
+            fprintf(stderr, "warning: could not load bundle %s\n", [bundlePath UTF8String]);
+    }
+    [WO_TEST_SHARED_INSTANCE setStopsAfterFirstFailure:options->failFast];
+    [WO_TEST_SHARED_INSTANCE setDefaultTimeout:options->timeout];
+    for (NSString *className in options->classTimeouts)
+        [WO_TEST_SHARED_INSTANCE setTimeout:[[options->classTimeouts objectForKey:className] doubleValue] forClassName:className];
+    runWorker(commandDescriptor, reportDescriptor);
+    return EXIT_SUCCESS;
+}
+
+void runWorker(int commandDescriptor, int reportDescriptor)
+{
+    FILE *commands  = fdopen(commandDescriptor, "r");
+    FILE *reports   = fdopen(reportDescriptor, "w");
+    if (!commands || !reports)
+    {
+        perror("error: fdopen");
+        return;
+    }
+    // let crashes and hangs terminate the process; the supervisor records them and starts a replacement
+    [WO_TEST_SHARED_INSTANCE setCatchesLowLevelExceptions:NO];
+    [WO_TEST_SHARED_INSTANCE setExitsOnTimeout:YES];
+    WOTestWorker *worker = [[WOTestWorker alloc] initWithProcessIdentifier:getpid() commandDescriptor:commandDescriptor
+                                                          reportDescriptor:reportDescriptor];
+    [worker runUnitsFromStream:commands reportingTo:reports];
+    fclose(commands);
+    fclose(reports);
+}
+
+void runIsolatedTests(NSArray *classNames, NSDictionary *descriptors, unsigned count)
+{
+    NSCParameterAssert(classNames != nil);
+    NSMutableArray *queue = [NSMutableArray arrayWithCapacity:[classNames count]];
+    for (NSString *className in [WO_TEST_SHARED_INSTANCE classNamesSortedByDuration:classNames])
+    {
+        // the names are only needed to send the methods down the command pipe
+        NSData *methods = [descriptors objectForKey:className];
+        if (!descriptors)
+            [queue addObject:[NSArray arrayWithObject:className]];
+        else if (methods)
+            [queue addObject:[[NSArray arrayWithObject:className]
+                              arrayByAddingObjectsFromArray:[WO_TEST_SHARED_INSTANCE methodNamesForDescriptors:methods]]];
+    }
+
+    if (count == 0)
+        count = 1;
+    if (count > [queue count])
+        count = [queue count];
+
+    // writes to the pipe of a worker which has just died must not kill the supervisor
+    signal(SIGPIPE, SIG_IGN);
+
+    NSMutableArray *workers = [NSMutableArray arrayWithCapacity:count];
+    for (unsigned i = 0; i < count; i++)
+    {
+        WOTestWorker *worker = [WOTestWorker spawnWorker];
+        if (worker)
+            [workers addObject:worker];
+    }
+
+    while ([workers count] > 0)
+    {
+        // with --fail-fast, let busy workers finish their current class but start nothing new
+        if ([WO_TEST_SHARED_INSTANCE stopped])
+            [queue removeAllObjects];
+
+        // hand out work to idle workers; one which has died while idle is replaced in place and the replacement gets the
+        // unit instead (at most count replacements per pass, so a worker which can't even start doesn't spawn forever)
+        unsigned i = 0, replaced = 0;
+        while (i < [workers count] && [queue count] > 0)
+        {
+            WOTestWorker *worker = [workers objectAtIndex:i];
+            if (worker.unit)
+                i++;
+            else if ([worker isAlive] && [worker runUnit:[queue objectAtIndex:0]])
+            {
+                [queue removeObjectAtIndex:0];
+                i++;
+            }
+            else
+            {
+                [worker reapAfterCrash];
+                WOTestWorker *replacement = (replaced++ < count) ? [WOTestWorker spawnWorker] : nil;
+                if (replacement)
+                    [workers replaceObjectAtIndex:i withObject:replacement];
+                else
+                    [workers removeObjectAtIndex:i];
+            }
+        }
+
+        fd_set readable;
+        FD_ZERO(&readable);
+        int maxDescriptor = -1;
+        for (WOTestWorker *worker in workers)
+        {
+            if (!worker.unit) continue;
+            FD_SET(worker.reportDescriptor, &readable);
+            maxDescriptor = MAX(maxDescriptor, worker.reportDescriptor);
+        }
+        if (maxDescriptor == -1)
+            break; // all workers idle and nothing left to do
+
+        // wake up at least once a second to check for workers which have hung
+        struct timeval interval = { 1, 0 };
+        int ready = select(maxDescriptor + 1, &readable, NULL, NULL, &interval);
+        if (ready == -1)
+        {
+            if (errno == EINTR) continue;
+            perror("error: select");
+            break;
+        }
+        for (WOTestWorker *worker in workers)
+            [worker killIfOverdue];
+        if (ready == 0)
+            continue;
+
+        for (WOTestWorker *worker in [NSArray arrayWithArray:workers])
+        {
+            if (!FD_ISSET(worker.reportDescriptor, &readable) || [worker readReports]) continue;
+
+            // worker died: record the crash, requeue the remainder and replace the worker
+            NSArray *remaining = [worker reapAfterCrash];
+            if (remaining)
+                [queue insertObject:remaining atIndex:0];
+            [workers removeObject:worker];
+            WOTestWorker *replacement = [WOTestWorker spawnWorker];
+            if (replacement)
+                [workers addObject:replacement];
+        }
+    }
+
+    for (WOTestWorker *worker in workers)
+        [worker terminate];
+
+    if ([queue count] > 0 && ![WO_TEST_SHARED_INSTANCE stopped])
+        [WO_TEST_SHARED_INSTANCE writeError:@"%u test classes could not be run because no worker processes were available",
+         (unsigned)[queue count]];
 }
 
 void showUsage(const char *name)
@@ -196,8 +1587,46 @@ void showUsage(const char *name)
      "Usage: %s [option]...\n"
      "-t, --test-class=CLASS         test only CLASS\n"
      "-e, --exclude-class=CLASS      test all but CLASS\n"
+     "-m, --test-method=PATTERN      test only methods matching PATTERN, which is\n"
+     "                               matched against \"Class/-method\" (or just\n"
+     "                               \"-method\" if it contains no \"/\"); PATTERN\n"
+     "                               is a glob, or a regular expression if\n"
+     "                               written as /regex/\n"
+     "-M, --exclude-method=PATTERN   test all but methods matching PATTERN\n"
      "-b, --test-bundle=BUNDLE       test only BUNDLE, loading if necessary\n"
      "-x, --exclude-bundle=BUNDLE    test all but BUNDLE\n"
+     "-j, --jobs=N                   run test classes on N worker threads\n"
+     "                               (0 uses one thread per available processor)\n"
+     "-i, --isolate                  run tests in child processes (as many as\n"
+     "                               --jobs), surviving crashes in test code\n"
+     "-T, --timings=FILE             read and update per-test durations in FILE\n"
+     "                               (default: WOTestTimings.plist, which sharded\n"
+     "                               runs read but never update)\n"
+     "    --shard-count=N            split the test methods into N shards using a\n"
+     "                               stable hash, and run only one of them\n"
+     "    --shard-index=I            run shard I (from 0 to N - 1; default 0)\n"
+     "    --shard-balanced           balance the shards using recorded timings\n"
+     "                               (all shards must use the same timings file)\n"
+     "-f, --fail-fast                stop starting new tests after the first failure\n"
+     "    --failures=FILE            read and update the list of failing methods in\n"
+     "                               FILE; these are run first\n"
+     "                               (default: WOTestFailures.plist)\n"
+     "-w, --watch                    keep running, testing again whenever a test\n"
+     "                               bundle changes (requires --test-bundle)\n"
+     "    --watch-path=PATH          watch source files under PATH; only classes\n"
+     "                               affected by changes there are tested again\n"
+     "    --timeout=SECONDS          report test methods which run for longer than\n"
+     "                               SECONDS (with --isolate, kill them too)\n"
+     "    --class-timeout=CLASS:SECONDS\n"
+     "                               use a different time budget for CLASS\n"
+     "-l, --list                     list the selected tests instead of running them\n"
+     "    --write-manifest=FILE      write a manifest of the tests in the bundles to\n"
+     "                               FILE instead of running them\n"
+     "    --manifest=FILE            with --list, take the tests from FILE instead\n"
+     "                               of loading the bundles; otherwise check FILE\n"
+     "                               against the bundles before running\n"
+     "    --profile-startup          print how long each phase of startup took\n"
+     "-q, --quiet                    count passing tests without printing them\n"
      "-v, --verbose                  verbose output (repeat for more verbosity)\n"
      "-V, --version                  show version information\n"
      "-h, --help                     show this usage information\n",